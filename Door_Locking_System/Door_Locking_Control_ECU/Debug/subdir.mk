@@ -6,27 +6,42 @@
 C_SRCS += \
 ../External_EEPROM_I2C.c \
 ../Motors.c \
+../crc.c \
+../credentials.c \
 ../external_eeprom.c \
 ../i2c.c \
+../internal_eeprom.c \
+../journal.c \
 ../main.c \
+../protocol.c \
 ../timers.c \
 ../uart.c 
 
 OBJS += \
 ./External_EEPROM_I2C.o \
 ./Motors.o \
+./crc.o \
+./credentials.o \
 ./external_eeprom.o \
 ./i2c.o \
+./internal_eeprom.o \
+./journal.o \
 ./main.o \
+./protocol.o \
 ./timers.o \
 ./uart.o 
 
 C_DEPS += \
 ./External_EEPROM_I2C.d \
 ./Motors.d \
+./crc.d \
+./credentials.d \
 ./external_eeprom.d \
 ./i2c.d \
+./internal_eeprom.d \
+./journal.d \
 ./main.d \
+./protocol.d \
 ./timers.d \
 ./uart.d 
 
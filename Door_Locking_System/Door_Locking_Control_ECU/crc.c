@@ -0,0 +1,92 @@
+ /******************************************************************************
+ *
+ * Module: CRC
+ *
+ * File Name: crc.c
+ *
+ * Description: Source file for the CRC calculation module
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#include "crc.h"
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	CRC8_update
+
+ [Description]:		Used to add one byte to a running CRC-8 calculation
+ 	 	 	 	 	(Useful when bytes are received one by one like UART)
+
+ [Args]:			crc, data
+
+ [in]				crc:  CRC value calculated till now (CRC8_INITIAL_VALUE at first)
+ 	 	 	 	 	data: New byte to be added to the calculation
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			New CRC value
+**********************************************************************************/
+uint8 CRC8_update(uint8 crc, uint8 data){
+
+	/* Iteration variable */
+	uint8 i;
+
+	crc ^= data;
+
+	/* Shift the 8 bits one by one and xor with the polynomial if MSB is set */
+	for(i = 0; i < 8; i++){
+
+		if(BIT_IS_SET(crc,7)){
+
+			crc = (uint8)( (crc << 1) ^ CRC8_POLYNOMIAL );
+		}
+		else{
+
+			crc = (uint8)(crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	CRC8_calculate
+
+ [Description]:		Used to calculate CRC-8 of a whole buffer
+
+ [Args]:			crc, data_Ptr, length
+
+ [in]				crc:	  CRC value calculated till now (CRC8_INITIAL_VALUE at first)
+ 	 	 	 	 	data_Ptr: Pointer to the buffer
+ 	 	 	 	 	length:	  Number of bytes in the buffer
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			New CRC value
+**********************************************************************************/
+uint8 CRC8_calculate(uint8 crc, const uint8 *data_Ptr, uint8 length){
+
+	/* Iteration variable */
+	uint8 i;
+
+	for(i = 0; i < length; i++){
+
+		crc = CRC8_update(crc, data_Ptr[i]);
+	}
+
+	return crc;
+}
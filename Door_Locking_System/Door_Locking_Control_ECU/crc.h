@@ -0,0 +1,82 @@
+ /******************************************************************************
+ *
+ * Module: CRC
+ *
+ * File Name: crc.h
+ *
+ * Description: Header file for the CRC calculation module
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#ifndef CRC_H_
+#define CRC_H_
+
+/****************************************** Includes *********************************************/
+
+#include "std_types.h"
+#include "common_macros.h"
+
+/************************************************************************************************/
+
+
+/******************************************* Macros *********************************************/
+
+/* CRC-8 Polynomial x^8 + x^2 + x + 1 (CRC-8/SMBUS) */
+#define CRC8_POLYNOMIAL			(0x07U)
+
+/* Initial value of CRC-8 calculation */
+#define CRC8_INITIAL_VALUE		(0x00U)
+
+/************************************************************************************************/
+
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	CRC8_update
+
+ [Description]:		Used to add one byte to a running CRC-8 calculation
+ 	 	 	 	 	(Useful when bytes are received one by one like UART)
+
+ [Args]:			crc, data
+
+ [in]				crc:  CRC value calculated till now (CRC8_INITIAL_VALUE at first)
+ 	 	 	 	 	data: New byte to be added to the calculation
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			New CRC value
+**********************************************************************************/
+uint8 CRC8_update(uint8 crc, uint8 data);
+
+
+/********************************************************************************
+ [Function Name]:	CRC8_calculate
+
+ [Description]:		Used to calculate CRC-8 of a whole buffer
+
+ [Args]:			crc, data_Ptr, length
+
+ [in]				crc:	  CRC value calculated till now (CRC8_INITIAL_VALUE at first)
+ 	 	 	 	 	data_Ptr: Pointer to the buffer
+ 	 	 	 	 	length:	  Number of bytes in the buffer
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			New CRC value
+**********************************************************************************/
+uint8 CRC8_calculate(uint8 crc, const uint8 *data_Ptr, uint8 length);
+
+
+#endif /* CRC_H_ */
@@ -0,0 +1,473 @@
+ /******************************************************************************
+ *
+ * Module: Credentials
+ *
+ * File Name: credentials.c
+ *
+ * Description: Source file for the user codes table on External EEPROM
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#include "credentials.h"
+#include "crc.h"
+
+/* Index of the first code digit and of the CRC-8 byte in a record */
+#define CREDENTIALS_CODE_INDEX		(1U)
+#define CREDENTIALS_CRC_INDEX		(CREDENTIALS_RECORD_SIZE - 1U)
+
+/* CRC-8 start value of a record (NOT 0x00, so an all zeros slot is not a valid record) */
+#define CREDENTIALS_CRC_SEED		(0x3CU)
+
+/*******************************************************************************
+ *                           Types Declaration                                 *
+ *******************************************************************************/
+
+/* Index entry: hash of the code and the table slot of its record */
+typedef struct{
+
+	uint16 Key;
+	uint8 Slot;
+
+}Credentials_IndexType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* TRUE after the table is scanned successfully */
+static uint8 g_credentialsScanned = FALSE;
+
+/* Index entries sorted by Key (g_indexCount entries are used) */
+static Credentials_IndexType g_index[CREDENTIALS_MAX_USERS];
+static uint8 g_indexCount = 0;
+
+/* User ID of every slot (CREDENTIALS_FREE_USER_ID for free slots) */
+static uint8 g_slotUser[CREDENTIALS_MAX_USERS];
+
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* EEPROM address of a table slot */
+static uint16 Credentials_slotAddress(uint8 slot){
+
+	return (uint16)( CREDENTIALS_START_ADDRESS + ( (uint16)slot * CREDENTIALS_RECORD_SIZE ) );
+}
+
+
+/* 16 bit hash of a code (djb2) */
+static uint16 Credentials_hash(const uint8 *code){
+
+	uint16 hash = 5381U;
+	uint8 i;
+
+	for(i = 0; i < CREDENTIALS_CODE_LENGTH; i++){
+
+		hash = (uint16)( ( (hash << 5) + hash ) ^ code[i] );
+	}
+
+	return hash;
+}
+
+
+/* Check the CRC of a record (Free slots are not valid) */
+static uint8 Credentials_recordValid(const uint8 *record){
+
+	if(record[0] == CREDENTIALS_FREE_USER_ID){
+
+		return FALSE;
+	}
+
+	return ( (CRC8_calculate(CREDENTIALS_CRC_SEED, record, CREDENTIALS_CRC_INDEX) == record[CREDENTIALS_CRC_INDEX]) ? TRUE : FALSE );
+}
+
+
+/* Position of the first index entry with a Key not less than the given one (Binary search) */
+static uint8 Credentials_lowerBound(uint16 key){
+
+	uint8 low	= 0;
+	uint8 high	= g_indexCount;
+	uint8 middle;
+
+	while(low < high){
+
+		middle = (uint8)( (low + high) / 2U );
+
+		if(g_index[middle].Key < key){
+
+			low = (uint8)(middle + 1U);
+		}
+		else{
+
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+
+/* Add an entry keeping the index sorted */
+static void Credentials_indexInsert(uint16 key, uint8 slot){
+
+	uint8 position = Credentials_lowerBound(key);
+	uint8 i;
+
+	for(i = g_indexCount; i > position; i--){
+
+		g_index[i] = g_index[i - 1U];
+	}
+
+	g_index[position].Key	= key;
+	g_index[position].Slot	= slot;
+
+	g_indexCount++;
+}
+
+
+/* Remove the entry of a slot keeping the index sorted */
+static void Credentials_indexRemove(uint8 slot){
+
+	uint8 i = 0;
+
+	while( (i < g_indexCount) && (g_index[i].Slot != slot) ){
+
+		i++;
+	}
+
+	if(i == g_indexCount){
+
+		return;
+	}
+
+	g_indexCount--;
+
+	for(; i < g_indexCount; i++){
+
+		g_index[i] = g_index[i + 1U];
+	}
+}
+
+
+/* Slot of an enrolled user, CREDENTIALS_MAX_USERS if the user is not enrolled */
+static uint8 Credentials_userSlot(uint8 userId){
+
+	uint8 slot = 0;
+
+	while( (slot < CREDENTIALS_MAX_USERS) && (g_slotUser[slot] != userId) ){
+
+		slot++;
+	}
+
+	return slot;
+}
+
+
+/* Write a record and update the SRAM data of its slot */
+static Credentials_StatusType Credentials_writeSlot(uint8 slot, uint8 userId, const uint8 *code){
+
+	uint8 record[CREDENTIALS_RECORD_SIZE];
+	uint8 i;
+
+	/* Free slot is all 0xFF (Same as an erased EEPROM) */
+	for(i = 0; i < CREDENTIALS_RECORD_SIZE; i++){
+
+		record[i] = 0xFF;
+	}
+
+	if(userId != CREDENTIALS_FREE_USER_ID){
+
+		record[0] = userId;
+
+		for(i = 0; i < CREDENTIALS_CODE_LENGTH; i++){
+
+			record[CREDENTIALS_CODE_INDEX + i] = code[i];
+		}
+
+		record[CREDENTIALS_CRC_INDEX] = CRC8_calculate(CREDENTIALS_CRC_SEED, record, CREDENTIALS_CRC_INDEX);
+	}
+
+	if(EEPROM_writePage(Credentials_slotAddress(slot), record, CREDENTIALS_RECORD_SIZE) != EEPROM_OK){
+
+		return CREDENTIALS_ERROR;
+	}
+
+	if(g_slotUser[slot] != CREDENTIALS_FREE_USER_ID){
+
+		Credentials_indexRemove(slot);
+	}
+
+	if(userId != CREDENTIALS_FREE_USER_ID){
+
+		Credentials_indexInsert(Credentials_hash(code), slot);
+	}
+
+	g_slotUser[slot] = userId;
+
+	return CREDENTIALS_OK;
+}
+
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	Credentials_init
+
+ [Description]:		Used to build the SRAM index by scanning the table one page
+ 	 	 	 	 	at a time (EEPROM_init must be called first)
+ 	 	 	 	 	Records with a wrong CRC are taken as free slots
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			CREDENTIALS_OK, or CREDENTIALS_ERROR if EEPROM can NOT be read
+**********************************************************************************/
+Credentials_StatusType Credentials_init(void){
+
+	/* One page of records */
+	uint8 page[EEPROM_PAGE_SIZE];
+
+	/* Slot of the first record in the page */
+	uint8 slot = 0;
+
+	/* Index of a record in the page */
+	uint8 i;
+
+	g_credentialsScanned	= FALSE;
+	g_indexCount			= 0;
+
+	for(slot = 0; slot < CREDENTIALS_MAX_USERS; slot++){
+
+		g_slotUser[slot] = CREDENTIALS_FREE_USER_ID;
+	}
+
+	slot = 0;
+
+	while(slot < CREDENTIALS_MAX_USERS){
+
+		/* One sequential read for every page */
+		if(EEPROM_readBlock(Credentials_slotAddress(slot), page, EEPROM_PAGE_SIZE) != EEPROM_OK){
+
+			return CREDENTIALS_ERROR;
+		}
+
+		for(i = 0; i < EEPROM_PAGE_SIZE; i += CREDENTIALS_RECORD_SIZE){
+
+			/* A user ID saved twice (Should NOT happen) keeps its first slot only */
+			if( Credentials_recordValid(&page[i]) && (Credentials_userSlot(page[i]) == CREDENTIALS_MAX_USERS) ){
+
+				g_slotUser[slot] = page[i];
+				Credentials_indexInsert(Credentials_hash(&page[i + CREDENTIALS_CODE_INDEX]), slot);
+			}
+
+			slot++;
+		}
+	}
+
+	g_credentialsScanned = TRUE;
+
+	return CREDENTIALS_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Credentials_find
+
+ [Description]:		Used to find the user of a code
+ 	 	 	 	 	(Binary search in the index, then one record read for every
+ 	 	 	 	 	user with the same hash to compare the whole code)
+
+ [Args]:			code, userId
+
+ [in]				code: Array of CREDENTIALS_CODE_LENGTH digits
+
+ [out]				userId: Pointer to save the User ID of the code owner on it
+
+ [in/out]			None
+
+ [Returns]:			CREDENTIALS_OK if found, CREDENTIALS_NOT_FOUND if no user has
+ 	 	 	 	 	this code, CREDENTIALS_ERROR if EEPROM can NOT be read
+**********************************************************************************/
+Credentials_StatusType Credentials_find(const uint8 *code, uint8 *userId){
+
+	uint8 record[CREDENTIALS_RECORD_SIZE];
+
+	uint16 key = Credentials_hash(code);
+	uint8 position;
+	uint8 i;
+
+	/* Index is NOT known if the scan failed, so scan again (No user is not assumed) */
+	if( (g_credentialsScanned == FALSE) && (Credentials_init() == CREDENTIALS_ERROR) ){
+
+		return CREDENTIALS_ERROR;
+	}
+
+	for(position = Credentials_lowerBound(key); (position < g_indexCount) && (g_index[position].Key == key); position++){
+
+		if(EEPROM_readBlock(Credentials_slotAddress(g_index[position].Slot), record, CREDENTIALS_RECORD_SIZE) != EEPROM_OK){
+
+			return CREDENTIALS_ERROR;
+		}
+
+		if(Credentials_recordValid(record) == FALSE){
+
+			continue;
+		}
+
+		i = 0;
+
+		while( (i < CREDENTIALS_CODE_LENGTH) && (record[CREDENTIALS_CODE_INDEX + i] == code[i]) ){
+
+			i++;
+		}
+
+		if(i == CREDENTIALS_CODE_LENGTH){
+
+			*userId = record[0];
+			return CREDENTIALS_OK;
+		}
+	}
+
+	return CREDENTIALS_NOT_FOUND;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Credentials_enroll
+
+ [Description]:		Used to save the code of a user (One page write)
+ 	 	 	 	 	- A new user takes the first free slot
+ 	 	 	 	 	- An enrolled user gets its code replaced in the same slot
+
+ [Args]:			userId, code
+
+ [in]				userId: User ID (0 to 254)
+ 	 	 	 	 	code:	Array of CREDENTIALS_CODE_LENGTH digits
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			CREDENTIALS_OK if saved, CREDENTIALS_DUPLICATE if another user
+ 	 	 	 	 	has this code, CREDENTIALS_FULL if there is no free slot,
+ 	 	 	 	 	CREDENTIALS_ERROR otherwise
+**********************************************************************************/
+Credentials_StatusType Credentials_enroll(uint8 userId, const uint8 *code){
+
+	uint8 owner;
+	uint8 slot;
+
+	if(userId == CREDENTIALS_FREE_USER_ID){
+
+		return CREDENTIALS_ERROR;
+	}
+
+	/* Two users with one code can NOT be told apart */
+	switch(Credentials_find(code, &owner)){
+
+	case CREDENTIALS_OK:
+
+		return ( (owner == userId) ? CREDENTIALS_OK : CREDENTIALS_DUPLICATE );
+
+	case CREDENTIALS_NOT_FOUND:
+
+		break;
+
+	default:
+
+		return CREDENTIALS_ERROR;
+	}
+
+	slot = Credentials_userSlot(userId);
+
+	if(slot == CREDENTIALS_MAX_USERS){
+
+		slot = Credentials_userSlot(CREDENTIALS_FREE_USER_ID);
+	}
+
+	if(slot == CREDENTIALS_MAX_USERS){
+
+		return CREDENTIALS_FULL;
+	}
+
+	return Credentials_writeSlot(slot, userId, code);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Credentials_remove
+
+ [Description]:		Used to remove a user by erasing its record (One page write)
+
+ [Args]:			userId
+
+ [in]				userId: User ID to be removed
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			CREDENTIALS_OK if removed, CREDENTIALS_NOT_FOUND if the user is
+ 	 	 	 	 	not enrolled, CREDENTIALS_ERROR otherwise
+**********************************************************************************/
+Credentials_StatusType Credentials_remove(uint8 userId){
+
+	uint8 slot;
+
+	if(userId == CREDENTIALS_FREE_USER_ID){
+
+		return CREDENTIALS_ERROR;
+	}
+
+	if( (g_credentialsScanned == FALSE) && (Credentials_init() == CREDENTIALS_ERROR) ){
+
+		return CREDENTIALS_ERROR;
+	}
+
+	slot = Credentials_userSlot(userId);
+
+	if(slot == CREDENTIALS_MAX_USERS){
+
+		return CREDENTIALS_NOT_FOUND;
+	}
+
+	return Credentials_writeSlot(slot, CREDENTIALS_FREE_USER_ID, NULL_PTR);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Credentials_count
+
+ [Description]:		Used to get the number of enrolled users
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Number of enrolled users
+**********************************************************************************/
+uint8 Credentials_count(void){
+
+	return g_indexCount;
+}
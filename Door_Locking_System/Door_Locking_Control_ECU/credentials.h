@@ -0,0 +1,202 @@
+ /******************************************************************************
+ *
+ * Module: Credentials
+ *
+ * File Name: credentials.h
+ *
+ * Description: Header file for the user codes table on External EEPROM
+ * 				- Every user has one record (User ID, Code, CRC-8) in a table slot
+ * 				- SRAM has only a sorted index of 16 bit code hashes, so a code is
+ * 				  found by a binary search and one EEPROM record read
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#ifndef CREDENTIALS_H_
+#define CREDENTIALS_H_
+
+/****************************************** Includes *********************************************/
+
+#include "std_types.h"
+#include "external_eeprom.h"
+
+/************************************************************************************************/
+
+
+/******************************************* Macros *********************************************/
+
+/* Number of digits in one user code */
+#define CREDENTIALS_CODE_LENGTH			(5U)
+
+/*
+ * Record layout: User ID, Code, Unused byte (0xFF), CRC-8 of all bytes before it
+ * Record size MUST divide EEPROM_PAGE_SIZE so a record never crosses a page
+*/
+#define CREDENTIALS_RECORD_SIZE			(8U)
+
+/*
+ * EEPROM region of the table (CREDENTIALS_MAX_USERS records from CREDENTIALS_START_ADDRESS)
+ * On-chip EEPROM: second half of it after the password journal
+ * (32 users on ATmega32, 16 users on ATmega16)
+*/
+#if (EEPROM_BACKEND == EEPROM_BACKEND_INTERNAL)
+#define CREDENTIALS_START_ADDRESS		(EEPROM_SIZE / 2U)
+#define CREDENTIALS_MAX_USERS			( (EEPROM_SIZE >= 1024UL) ? 32U : 16U )
+#else
+#define CREDENTIALS_START_ADDRESS		(0x0600U)
+#define CREDENTIALS_MAX_USERS			(32U)
+#endif
+
+/* User ID of a free slot (0xFF), it is never given to a user */
+#define CREDENTIALS_FREE_USER_ID		(0xFFU)
+
+#if ( (1U + CREDENTIALS_CODE_LENGTH + 1U) > CREDENTIALS_RECORD_SIZE )
+#error "CREDENTIALS_RECORD_SIZE is too small for CREDENTIALS_CODE_LENGTH"
+#endif
+
+#if ( (EEPROM_PAGE_SIZE % CREDENTIALS_RECORD_SIZE) != 0U ) || ( (CREDENTIALS_START_ADDRESS % CREDENTIALS_RECORD_SIZE) != 0U )
+#error "Credential records must not cross EEPROM pages"
+#endif
+
+#if ( ( (CREDENTIALS_MAX_USERS * CREDENTIALS_RECORD_SIZE) % EEPROM_PAGE_SIZE ) != 0U ) || (CREDENTIALS_MAX_USERS > 254U)
+#error "Credentials table must be whole pages and not more than 254 users"
+#endif
+
+#if ( CREDENTIALS_START_ADDRESS + (CREDENTIALS_MAX_USERS * CREDENTIALS_RECORD_SIZE) ) > EEPROM_SIZE
+#error "Credentials table does not fit in the selected EEPROM"
+#endif
+
+/************************************************************************************************/
+
+
+/********************************** User Define Data Types **************************************/
+
+/********************************************************************************
+
+ [Enumuration Name]:		Credentials_StatusType
+
+ [Enumuration Description]: Result of a credentials table operation
+
+*********************************************************************************/
+typedef enum{
+
+	CREDENTIALS_OK,
+	CREDENTIALS_NOT_FOUND,		/* No user has this code (or this User ID)		*/
+	CREDENTIALS_DUPLICATE,		/* Code is already used by another user			*/
+	CREDENTIALS_FULL,			/* No free slot for a new user					*/
+	CREDENTIALS_ERROR			/* EEPROM access failed or User ID is not valid	*/
+
+}Credentials_StatusType;
+
+/************************************************************************************************/
+
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	Credentials_init
+
+ [Description]:		Used to build the SRAM index by scanning the table one page
+ 	 	 	 	 	 	at a time (EEPROM_init must be called first)
+ 	 	 	 	 	 	Records with a wrong CRC are taken as free slots
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			CREDENTIALS_OK, or CREDENTIALS_ERROR if EEPROM can NOT be read
+**********************************************************************************/
+Credentials_StatusType Credentials_init(void);
+
+
+/********************************************************************************
+ [Function Name]:	Credentials_find
+
+ [Description]:		Used to find the user of a code
+ 	 	 	 	 	 	(Binary search in the index, then one record read for every
+ 	 	 	 	 	 	user with the same hash to compare the whole code)
+
+ [Args]:			code, userId
+
+ [in]				code: Array of CREDENTIALS_CODE_LENGTH digits
+
+ [out]				userId: Pointer to save the User ID of the code owner on it
+
+ [in/out]			None
+
+ [Returns]:			CREDENTIALS_OK if found, CREDENTIALS_NOT_FOUND if no user has
+ 	 	 	 	 	 	this code, CREDENTIALS_ERROR if EEPROM can NOT be read
+**********************************************************************************/
+Credentials_StatusType Credentials_find(const uint8 *code, uint8 *userId);
+
+
+/********************************************************************************
+ [Function Name]:	Credentials_enroll
+
+ [Description]:		Used to save the code of a user (One page write)
+ 	 	 	 	 	 	- A new user takes the first free slot
+ 	 	 	 	 	 	- An enrolled user gets its code replaced in the same slot
+
+ [Args]:			userId, code
+
+ [in]				userId: User ID (0 to 254)
+ 	 	 	 	 	 	code:	Array of CREDENTIALS_CODE_LENGTH digits
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			CREDENTIALS_OK if saved, CREDENTIALS_DUPLICATE if another user
+ 	 	 	 	 	 	has this code, CREDENTIALS_FULL if there is no free slot,
+ 	 	 	 	 	 	CREDENTIALS_ERROR otherwise
+**********************************************************************************/
+Credentials_StatusType Credentials_enroll(uint8 userId, const uint8 *code);
+
+
+/********************************************************************************
+ [Function Name]:	Credentials_remove
+
+ [Description]:		Used to remove a user by erasing its record (One page write)
+
+ [Args]:			userId
+
+ [in]				userId: User ID to be removed
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			CREDENTIALS_OK if removed, CREDENTIALS_NOT_FOUND if the user is
+ 	 	 	 	 	 	not enrolled, CREDENTIALS_ERROR otherwise
+**********************************************************************************/
+Credentials_StatusType Credentials_remove(uint8 userId);
+
+
+/********************************************************************************
+ [Function Name]:	Credentials_count
+
+ [Description]:		Used to get the number of enrolled users
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Number of enrolled users
+**********************************************************************************/
+uint8 Credentials_count(void);
+
+#endif /* CREDENTIALS_H_ */
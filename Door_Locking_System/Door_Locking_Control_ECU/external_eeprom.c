@@ -16,6 +16,281 @@
 #include "i2c.h"
 #include "external_eeprom.h"
 
+/* On-chip EEPROM backend is in internal_eeprom.c */
+#if (EEPROM_BACKEND == EEPROM_BACKEND_EXTERNAL)
+
+/* Bus speed used by EEPROM_init, the fastest one both the EEPROM and F_CPU can reach */
+#define EEPROM_BIT_RATE		TWI_FASTEST_BIT_RATE(EEPROM_MAX_BIT_RATE)
+
+#if !TWI_BIT_RATE_VALID(EEPROM_BIT_RATE)
+#error "EEPROM bit rate can NOT be generated from F_CPU"
+#endif
+
+/*
+ * 7 bits device address: Most significant 4 bits are 1010 (0x50)
+ * - Up to 24C16: the least significant 3 bits are the memory address bits above 8
+ *   (As many as the part needs) and the A pins for the rest of them
+ * - 24C32 and above: the least significant 3 bits are the A pins, all memory
+ *   address bits are in the 2 bytes word address
+*/
+#if (EEPROM_WORD_ADDRESS_SIZE == 1U) && (EEPROM_SIZE > 256UL)
+#define EEPROM_BLOCK_MASK				( (uint8)( (EEPROM_SIZE / 256UL) - 1UL ) )
+#else
+#define EEPROM_BLOCK_MASK				(0x00U)
+#endif
+
+#define EEPROM_DEVICE_ADDRESS(ADDRESS)	( (uint8)( 0x50U | ( EEPROM_CHIP_SELECT & 0x07U & (uint8)(~EEPROM_BLOCK_MASK) ) | \
+											   ( (uint8)( (ADDRESS) >> 8 ) & EEPROM_BLOCK_MASK ) ) )
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* TRUE from a write till the EEPROM acknowledges its address again (Write cycle ended) */
+static uint8 g_writeCyclePending = FALSE;
+
+/* Device address of the last write (The device which is in its write cycle) */
+static uint8 g_writeCycleDevice;
+
+/* Steps of the background write (EEPROM_writeBlockAsync) */
+#define EEPROM_ASYNC_IDLE			(0U)	/* No background write						*/
+#define EEPROM_ASYNC_PAGE			(1U)	/* Page write transaction is running		*/
+#define EEPROM_ASYNC_POLL_WAIT		(2U)	/* Write cycle, next tick sends an ACK poll	*/
+#define EEPROM_ASYNC_POLL			(3U)	/* ACK poll transaction is running			*/
+
+static volatile uint8 g_asyncState = EEPROM_ASYNC_IDLE;
+
+/* Bytes of the background write which are not written yet */
+static uint16 g_asyncAddress;
+static const uint8 *g_asyncData;
+static uint16 g_asyncLength;
+
+/* Number of bytes in the running page write */
+static uint8 g_asyncChunk;
+
+/* Ticks left for the running write cycle */
+static uint8 g_asyncPollTicks;
+
+/* Ticks left for a page write or ACK poll queued behind a pending TWI bus recovery */
+static uint8 g_asyncStallTicks;
+
+/* Word address and data of the running page write, and its transaction */
+static uint8 g_asyncFrame[EEPROM_WORD_ADDRESS_SIZE + EEPROM_PAGE_SIZE];
+static TWI_TransactionType g_asyncTransaction;
+
+/* Pointer to the function called with the result of the background write */
+static void (*volatile g_asyncCallBackPtr)(EEPROM_StatusType status) = NULL_PTR;
+
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Convert the result of a TWI transfer to the EEPROM status */
+static EEPROM_StatusType EEPROM_status(TWI_StatusType status){
+
+	switch(status){
+
+	case TWI_OK:
+
+		return EEPROM_OK;
+
+	case TWI_ADDRESS_NACK:
+	case TWI_DATA_NACK:
+
+		return EEPROM_NACK;
+
+	case TWI_TIMEOUT:
+
+		return EEPROM_TIMEOUT;
+
+	default:
+
+		return EEPROM_BUS_ERROR;
+	}
+}
+
+
+/*
+ * Wait for the write cycle of the last write by ACK polling
+ * EEPROM does not acknowledge its address till the cycle ends, so waiting
+ * takes exactly the time the chip needs (No wait if no write is pending)
+*/
+static EEPROM_StatusType EEPROM_waitWriteCycle(void){
+
+	TWI_StatusType status;
+
+	/* Number of polls, limited to the longest write cycle */
+	uint8 poll;
+
+	/* Background write may wait for the bus recovery after a TWI timeout */
+	if(BIT_IS_SET(SREG,7)){
+
+		TWI_recoverPending();
+	}
+
+	/* Background write owns the EEPROM till it ends (Its callback comes from an ISR) */
+	while(g_asyncState != EEPROM_ASYNC_IDLE){}
+
+	if(g_writeCyclePending == FALSE){
+
+		return EEPROM_OK;
+	}
+
+	for(poll = 0; poll <= ( (EEPROM_WRITE_CYCLE_MS * 1000U) / EEPROM_ACK_POLL_US ); poll++){
+
+		/* Address only write, ACK means the write cycle ended */
+		status = TWI_transfer(g_writeCycleDevice, NULL_PTR, 0, NULL_PTR, 0);
+
+		if(status != TWI_ADDRESS_NACK){
+
+			g_writeCyclePending = FALSE;
+
+			return EEPROM_status(status);
+		}
+
+		_delay_us(EEPROM_ACK_POLL_US);
+	}
+
+	return EEPROM_NACK;
+}
+
+
+/* Put the word address of a memory address at the frame start (Its size is fixed by the part) */
+static void EEPROM_setWordAddress(uint8 *frame, uint16 u16addr){
+
+#if (EEPROM_WORD_ADDRESS_SIZE == 2U)
+	frame[0] = (uint8)(u16addr >> 8);
+	frame[1] = (uint8)(u16addr);
+#else
+	frame[0] = (uint8)(u16addr);
+#endif
+}
+
+
+/* Start tracking the write cycle of a successful write */
+static EEPROM_StatusType EEPROM_startWriteCycle(uint16 u16addr, EEPROM_StatusType status){
+
+	if(status == EEPROM_OK){
+
+		g_writeCyclePending	= TRUE;
+		g_writeCycleDevice	= EEPROM_DEVICE_ADDRESS(u16addr);
+	}
+
+	return status;
+}
+
+
+/* End the background write then give its result to the callback */
+static void EEPROM_asyncEnd(EEPROM_StatusType status){
+
+	g_asyncState = EEPROM_ASYNC_IDLE;
+
+	if(g_asyncCallBackPtr != NULL_PTR){
+
+		(*g_asyncCallBackPtr)(status);
+	}
+}
+
+
+/* ACK poll of the background write cycle ended (Called from TWI ISR) */
+static void EEPROM_asyncPollDone(TWI_StatusType status);
+
+
+/* Page write of the background write ended (Called from TWI ISR) */
+static void EEPROM_asyncPageDone(TWI_StatusType status){
+
+	if(status != TWI_OK){
+
+		EEPROM_asyncEnd(EEPROM_status(status));
+		return;
+	}
+
+	g_writeCyclePending	= TRUE;
+	g_writeCycleDevice	= EEPROM_DEVICE_ADDRESS(g_asyncAddress);
+
+	g_asyncAddress	+= g_asyncChunk;
+	g_asyncData		+= g_asyncChunk;
+	g_asyncLength	-= g_asyncChunk;
+
+	/* Write cycle is polled from the timer tick */
+	g_asyncPollTicks	= EEPROM_WRITE_CYCLE_TICKS;
+	g_asyncState		= EEPROM_ASYNC_POLL_WAIT;
+}
+
+
+/* Start the page write of the next background bytes (Till the page end) */
+static EEPROM_StatusType EEPROM_asyncPage(void){
+
+	uint8 i;
+
+	g_asyncChunk = (uint8)(EEPROM_PAGE_SIZE - (g_asyncAddress % EEPROM_PAGE_SIZE));
+
+	if(g_asyncChunk > g_asyncLength){
+
+		g_asyncChunk = (uint8)g_asyncLength;
+	}
+
+	EEPROM_setWordAddress(g_asyncFrame, g_asyncAddress);
+
+	for(i = 0; i < g_asyncChunk; i++){
+
+		g_asyncFrame[EEPROM_WORD_ADDRESS_SIZE + i] = g_asyncData[i];
+	}
+
+	g_asyncTransaction.SlaveAddress	= EEPROM_DEVICE_ADDRESS(g_asyncAddress);
+	g_asyncTransaction.TxBuffer		= g_asyncFrame;
+	g_asyncTransaction.TxLength		= (uint8)(EEPROM_WORD_ADDRESS_SIZE + g_asyncChunk);
+	g_asyncTransaction.RxBuffer		= NULL_PTR;
+	g_asyncTransaction.RxLength		= 0;
+	g_asyncTransaction.CallBack		= EEPROM_asyncPageDone;
+
+	g_asyncState		= EEPROM_ASYNC_PAGE;
+	g_asyncStallTicks	= EEPROM_WRITE_CYCLE_TICKS;
+
+	return ( (TWI_submitTransaction(&g_asyncTransaction) == TWI_OK) ? EEPROM_OK : EEPROM_BUSY );
+}
+
+
+static void EEPROM_asyncPollDone(TWI_StatusType status){
+
+	EEPROM_StatusType result;
+
+	if(status == TWI_ADDRESS_NACK){
+
+		/* Still in its write cycle, poll again next tick */
+		g_asyncState = EEPROM_ASYNC_POLL_WAIT;
+		return;
+	}
+
+	if(status != TWI_OK){
+
+		EEPROM_asyncEnd(EEPROM_status(status));
+		return;
+	}
+
+	g_writeCyclePending = FALSE;
+
+	if(g_asyncLength == 0){
+
+		EEPROM_asyncEnd(EEPROM_OK);
+		return;
+	}
+
+	/* Next page starts as soon as the previous write cycle ends */
+	result = EEPROM_asyncPage();
+
+	if(result != EEPROM_OK){
+
+		EEPROM_asyncEnd(result);
+	}
+}
+
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
 /********************************************************************************
  [Function Name]:	EEPROM_init
 
@@ -37,8 +312,9 @@ void EEPROM_init(void)
 	TWI_ConfigType twi_Struct;
 
 	twi_Struct.Address		 = ADDRESS_OF_MC_IN_SLAVE_MODE;
-	twi_Struct.BitRate		 = FAST_MODE_400KB;
+	twi_Struct.BitRate		 = EEPROM_BIT_RATE;
 	twi_Struct.InterruptMode = INTERRUPT_MODE_DISABLE;
+	twi_Struct.SlaveMode	 = SLAVE_MODE_DISABLE;
 
 	/* Initializa I2C Module */
 	TWI_init(&twi_Struct);
@@ -72,171 +348,391 @@ void EEPROM_init(void)
 
  [in/out]			None
 
- [Returns]:			Status of writing (SUCCESS if everything is fine)
+ [Returns]:			Status of writing (EEPROM_OK if everything is fine)
 **********************************************************************************/
-uint8 EEPROM_writeByte(uint16 u16addr, uint8 u8data){
+EEPROM_StatusType EEPROM_writeByte(uint16 u16addr, uint8 u8data){
 
-	/* Send start bit to start I2C Frame */
-	TWI_start();
+	/* Word address then the data byte */
+	uint8 frame[EEPROM_WORD_ADDRESS_SIZE + 1U];
 
-	/* Check  of the status of sending Start bit */
-	if(TWI_getStatus() != TW_START){
+	EEPROM_StatusType status = EEPROM_waitWriteCycle();
 
-		/* Start bit did NOT Transmitted succesfully */
-		return ERROR;
+	if(status != EEPROM_OK){
+
+		return status;
 	}
 
-	/*
-	 * In 24C16 EEPROM, LSB is the word address, MSB is the device address
-	 * in the 8 bits of device address, Most significant 4 bits are 1010 (0xA)
-	 * but the least significant 4 bits are the last 3 bits of memory address
-	 * and the read/write bit (0 if write, 1 if read)
-	 *
-	 * so, we need to get most significant 3 bits from memory address
-	 * so, masking the msb with 0x0700 and right shift them to get saved
-	 * and the last bit is write (0)
-	*/
+	EEPROM_setWordAddress(frame, u16addr);
+	frame[EEPROM_WORD_ADDRESS_SIZE] = u8data;
+
+	status = EEPROM_status( TWI_transfer(EEPROM_DEVICE_ADDRESS(u16addr), frame, sizeof(frame), NULL_PTR, 0) );
+
+	return EEPROM_startWriteCycle(u16addr, status);
+}
 
-    TWI_write((uint8)(0xA0 | ((u16addr & 0x0700)>>7)));
 
-	/* Check of Sending Slave address and reciving its ACK Status */
-	if(TWI_getStatus() != TW_MT_SLA_W_ACK){
 
-		/* Error in sending slave address or receiving its ACK */
-		return ERROR;
+
+/********************************************************************************
+ [Function Name]:	EEPROM_readByte
+
+ [Description]:		Function used to read byte on EEPROM
+
+ [Args]:			u16addr, u8data
+
+ [in]				u16addr: Address of segment needed to be written on it
+
+ [out]				u8data:	 Pointer to an empty char to save the read byte on it
+
+ [in/out]			None
+
+ [Returns]:			Status of Reading (EEPROM_OK if everything is fine)
+**********************************************************************************/
+EEPROM_StatusType EEPROM_readByte(uint16 u16addr, uint8 *u8data)
+{
+	/* Word address written first, then one byte is read after a repeated start */
+	uint8 wordAddress[EEPROM_WORD_ADDRESS_SIZE];
+
+	/* Reads wait only if a write cycle is still running */
+	EEPROM_StatusType status = EEPROM_waitWriteCycle();
+
+	if(status != EEPROM_OK){
+
+		return status;
 	}
 
-	/* Send next byte which is the proper memory address */
-	TWI_write((uint8)(u16addr));
+	EEPROM_setWordAddress(wordAddress, u16addr);
+
+	return EEPROM_status( TWI_transfer(EEPROM_DEVICE_ADDRESS(u16addr), wordAddress, EEPROM_WORD_ADDRESS_SIZE, u8data, 1) );
+}
 
-	/* Check of transmitting data byte and receiving its ACK */
-	if(TWI_getStatus() != TW_MT_DATA_ACK){
 
-		/* Error in transmitting data byte or receiving its ACK */
-		return ERROR;
+
+/********************************************************************************
+ [Function Name]:	EEPROM_writePage
+
+ [Description]:		Function used to write bytes of one page on EEPROM in one
+ 	 	 	 	 	transaction and one write cycle
+ 	 	 	 	 	(Next access waits for the write cycle by ACK polling)
+
+ [Args]:			u16addr, data, length
+
+ [in]				u16addr: Address of the first byte
+ 	 	 	 	 	data:	 Bytes required to be written
+ 	 	 	 	 	length:	 Number of bytes (They MUST NOT cross the page end)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Status of writing (EEPROM_OK if everything is fine)
+**********************************************************************************/
+EEPROM_StatusType EEPROM_writePage(uint16 u16addr, const uint8 *data, uint8 length){
+
+	/* Word address then the data bytes */
+	uint8 frame[EEPROM_WORD_ADDRESS_SIZE + EEPROM_PAGE_SIZE];
+
+	uint8 i;
+
+	EEPROM_StatusType status;
+
+	/* EEPROM rolls over to the page start after its last byte, which overwrites other data */
+	if( ( (u16addr % EEPROM_PAGE_SIZE) + length ) > EEPROM_PAGE_SIZE ){
+
+		return EEPROM_PAGE_OVERFLOW;
 	}
 
-	/* Write Data byte on the EEPROM memory */
-	TWI_write(u8data);
+	status = EEPROM_waitWriteCycle();
 
-	/* Check of transmitting data byte and receiving its ACK */
-	if(TWI_getStatus() != TW_MT_DATA_ACK){
+	if(status != EEPROM_OK){
 
-		/* Error in transmitting data byte or receiving its ACK */
-		return ERROR;
+		return status;
 	}
 
-	/* Sending Stop bit to end the frame */
-	TWI_stop();
+	EEPROM_setWordAddress(frame, u16addr);
+
+	for(i = 0; i < length; i++){
 
-	/* Going to this point means that everything is fine */
-	return SUCCESS;
+		frame[EEPROM_WORD_ADDRESS_SIZE + i] = data[i];
+	}
+
+	status = EEPROM_status( TWI_transfer(EEPROM_DEVICE_ADDRESS(u16addr), frame, (uint8)(EEPROM_WORD_ADDRESS_SIZE + length), NULL_PTR, 0) );
+
+	return EEPROM_startWriteCycle(u16addr, status);
 }
 
 
 
+/********************************************************************************
+ [Function Name]:	EEPROM_writeBlock
+
+ [Description]:		Function used to write any number of bytes on EEPROM
+ 	 	 	 	 	- Bytes are split at page boundaries, one page write each
+ 	 	 	 	 	- Waits for the write cycle between pages by ACK polling
+ 	 	 	 	 	(Next access waits for the write cycle by ACK polling)
+
+ [Args]:			u16addr, data, length
+
+ [in]				u16addr: Address of the first byte
+ 	 	 	 	 	data:	 Bytes required to be written
+ 	 	 	 	 	length:	 Number of bytes
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Status of writing (EEPROM_OK if everything is fine)
+**********************************************************************************/
+EEPROM_StatusType EEPROM_writeBlock(uint16 u16addr, const uint8 *data, uint16 length){
+
+	EEPROM_StatusType status = EEPROM_OK;
+
+	/* Number of bytes written in the current page */
+	uint8 chunk;
+
+	while(length > 0){
+
+		/* Bytes till the end of the current page */
+		chunk = (uint8)(EEPROM_PAGE_SIZE - (u16addr % EEPROM_PAGE_SIZE));
+
+		if(chunk > length){
+
+			chunk = (uint8)length;
+		}
+
+		status = EEPROM_writePage(u16addr, data, chunk);
+
+		if(status != EEPROM_OK){
+
+			break;
+		}
+
+		/* Next page waits for the write cycle of this one by ACK polling */
+		u16addr	+= chunk;
+		data	+= chunk;
+		length	-= chunk;
+	}
+
+	return status;
+}
+
+
 
 /********************************************************************************
- [Function Name]:	EEPROM_readByte
+ [Function Name]:	EEPROM_readBlock
 
- [Description]:		Function used to read byte on EEPROM
+ [Description]:		Function used to read number of bytes from EEPROM with one
+ 	 	 	 	 	addressed sequential read (Every byte is ACKed except the last)
 
- [Args]:			u16addr, u8data
+ [Args]:			u16addr, data, length
 
- [in]				u16addr: Address of segment needed to be written on it
+ [in]				u16addr: Address of the first byte
+ 	 	 	 	 	length:	 Number of bytes
 
- [out]				u8data:	 Pointer to an empty char to save the read byte on it
+ [out]				data:	 Array to save the read bytes on it
 
  [in/out]			None
 
- [Returns]:			Status of Reading (SUCCESS if everything is fine)
+ [Returns]:			Status of Reading (EEPROM_OK if everything is fine)
 **********************************************************************************/
-uint8 EEPROM_readByte(uint16 u16addr, uint8 *u8data)
-{
-	/* Send start bit to start I2C Frame */
-	TWI_start();
+EEPROM_StatusType EEPROM_readBlock(uint16 u16addr, uint8 *data, uint16 length){
+
+	EEPROM_StatusType status = EEPROM_OK;
+
+	/* Word address of the current part */
+	uint8 wordAddress[EEPROM_WORD_ADDRESS_SIZE];
+
+	/* Number of bytes read in the current part (TWI_transfer reads up to 255 bytes) */
+	uint8 chunk;
+
+	/* Reads wait only if a write cycle is still running */
+	status = EEPROM_waitWriteCycle();
 
-	/* Check  of the status of sending Start bit */
-	if(TWI_getStatus() != TW_START){
+	while( (status == EEPROM_OK) && (length > 0) ){
 
-		/* Start bit did NOT Transmitted succesfully */
-		return ERROR;
+		chunk = ( (length > 255U) ? 255U : (uint8)length );
+
+		EEPROM_setWordAddress(wordAddress, u16addr);
+
+		status = EEPROM_status( TWI_transfer(EEPROM_DEVICE_ADDRESS(u16addr), wordAddress, EEPROM_WORD_ADDRESS_SIZE, data, chunk) );
+
+		if(status != EEPROM_OK){
+
+			break;
+		}
+
+		u16addr	+= chunk;
+		data	+= chunk;
+		length	-= chunk;
 	}
 
-	/*
-	 * In 24C16 EEPROM, LSB is the word address, MSB is the device address
-	 * in the 8 bits of device address, Most significant 4 bits are 1010 (0xA)
-	 * but the least significant 4 bits are the last 3 bits of memory address
-	 * and the read/write bit (0 if write, 1 if read)
-	 *
-	 * so, we need to get most significant 3 bits from memory address
-	 * so, masking the msb with 0x0700 and right shift them to get saved
-	 * and the last bit is write (0)
-	*/
+	return status;
+}
+
 
-    TWI_write((uint8)((0xA0) | ((u16addr & 0x0700)>>7)));
 
-	/* Check of Sending Slave address and reciving its ACK Status */
-	if(TWI_getStatus() != TW_MT_SLA_W_ACK){
+/********************************************************************************
+ [Function Name]:	EEPROM_writeBlockAsync
+
+ [Description]:		Function used to write any number of bytes on EEPROM in the
+ 	 	 	 	 	background without any busy wait
+ 	 	 	 	 	- Every page is one TWI transaction run from TWI ISR
+ 	 	 	 	 	- Its write cycle is ACK polled from EEPROM_writeCycleTick
+ 	 	 	 	 	- Callback is called from the ISR when the last write cycle ends
+ 	 	 	 	 	  or on the first error (At once if length is 0)
+ 	 	 	 	 	- Other EEPROM functions wait for the background write to end
+ 	 	 	 	 	  (Global Interrupts must be enabled, and they must NOT be
+ 	 	 	 	 	  called from ISRs while it is running)
+
+ [Args]:			u16addr, data, length, f_ptr
+
+ [in]				u16addr: Address of the first byte
+ 	 	 	 	 	data:	 Bytes required to be written (MUST stay valid till the callback)
+ 	 	 	 	 	length:	 Number of bytes
+ 	 	 	 	 	f_ptr:	 Pointer to the function called with the result
+ 	 	 	 	 	 	 	 (NULL_PTR if not needed)
 
-		/* Error in sending slave address or receiving its ACK */
-		return ERROR;
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			EEPROM_OK if the write started (Result comes to the callback),
+ 	 	 	 	 	EEPROM_BUSY if another background write is running
+**********************************************************************************/
+EEPROM_StatusType EEPROM_writeBlockAsync(uint16 u16addr, const uint8 *data, uint16 length, void (*f_ptr)(EEPROM_StatusType status)){
+
+	EEPROM_StatusType status = EEPROM_OK;
+
+	uint8 sreg = SREG;
+
+	/* Page write can NOT start while a TWI bus recovery waits for thread context */
+	if(BIT_IS_SET(sreg,7)){
+
+		TWI_recoverPending();
 	}
 
-	/* Send next byte which is the proper memory address */
-	TWI_write((uint8)(u16addr));
+	cli();
 
-	/* Check of transmitting data byte and receiving its ACK */
-	if(TWI_getStatus() != TW_MT_DATA_ACK){
+	if(g_asyncState != EEPROM_ASYNC_IDLE){
 
-		/* Error in transmitting data byte or receiving its ACK */
-		return ERROR;
+		SREG = sreg;
+		return EEPROM_BUSY;
 	}
 
-	/* Sending Repeated start Bit */
-	TWI_start();
+	g_asyncCallBackPtr	= f_ptr;
+	g_asyncAddress		= u16addr;
+	g_asyncData			= data;
+	g_asyncLength		= length;
+
+	if(length == 0){
 
-	/* Check of sending repeated start bit properly */
-	if(TWI_getStatus() != TW_REP_START){
+		/* Nothing to write, callback is called at once */
+		SREG = sreg;
 
-		/* Error in sending reapted start bit */
-		return ERROR;
+		EEPROM_asyncEnd(EEPROM_OK);
+		return EEPROM_OK;
 	}
 
-	/*
-	 * In 24C16 EEPROM, LSB is the word address, MSB is the device address
-	 * in the 8 bits of device address, Most significant 4 bits are 1010 (0xA)
-	 * but the least significant 4 bits are the last 3 bits of memory address
-	 * and the read/write bit (0 if write, 1 if read)
-	 *
-	 * so, we need to get most significant 3 bits from memory address
-	 * so, masking the msb with 0x0700 and right shift them to get saved
-	 * and the last bit is read (1)
-	*/
+	if(g_writeCyclePending == TRUE){
+
+		/* Write cycle of a previous write is still running, poll it first */
+		g_asyncPollTicks	= EEPROM_WRITE_CYCLE_TICKS;
+		g_asyncState		= EEPROM_ASYNC_POLL_WAIT;
+	}
+	else{
 
-    TWI_write((uint8)((0xA0) | ((u16addr & 0x0700)>>7) | 1));
+		status = EEPROM_asyncPage();
 
-	/* Check of Sending Slave address and reciving its ACK Status */
-	if(TWI_getStatus() != TW_MT_SLA_R_ACK){
+		if(status != EEPROM_OK){
 
-		/* Error in sending slave address or receiving its ACK */
-		return ERROR;
+			g_asyncState = EEPROM_ASYNC_IDLE;
+		}
 	}
 
-	/* Read required byte from EEPROM Memory without sending ACK */
-	 *u8data = TWI_readWithNACK();
+	SREG = sreg;
+
+	return status;
+}
 
-	/* Check of reading properly without sending ACK */
-	 if(TWI_getStatus() != TW_MR_DATA_NACK){
 
-		 /* Error in reading byte */
-		 return ERROR;
-	 }
 
-	 /* Sending STOP Bit */
-	 TWI_stop();
+/********************************************************************************
+ [Function Name]:	EEPROM_writeCycleTick
+
+ [Description]:		Time base of background writes, it should be given as a
+ 	 	 	 	 	callback to a timer which interrupts every EEPROM_TICK_MS
+ 	 	 	 	 	- Sends one ACK poll of the running write cycle every tick
+ 	 	 	 	 	- Write cycle longer than EEPROM_WRITE_CYCLE_MS ends the
+ 	 	 	 	 	  background write with EEPROM_NACK
+ 	 	 	 	 	- Page write or ACK poll queued behind a TWI bus recovery
+ 	 	 	 	 	  (It waits for a TWI call outside ISRs) for longer than
+ 	 	 	 	 	  EEPROM_WRITE_CYCLE_MS ends the background write with
+ 	 	 	 	 	  EEPROM_TIMEOUT
 
-	/* Going to this point means that everything is fine */
-	return SUCCESS;
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void EEPROM_writeCycleTick(void){
+
+	if( (g_asyncState == EEPROM_ASYNC_PAGE) || (g_asyncState == EEPROM_ASYNC_POLL) ){
+
+		/* Transaction is running or queued behind other ones, they end by themselves */
+		if(TWI_isRecoveryPending() == FALSE){
+
+			g_asyncStallTicks = EEPROM_WRITE_CYCLE_TICKS;
+			return;
+		}
+
+		if(g_asyncStallTicks > 0){
+
+			g_asyncStallTicks--;
+			return;
+		}
+
+		/* Nothing recovers the bus, take the transaction back from the queue and give up */
+		if(TWI_cancelTransaction(&g_asyncTransaction) == TWI_OK){
+
+			EEPROM_asyncEnd(EEPROM_TIMEOUT);
+		}
+
+		return;
+	}
+
+	if(g_asyncState != EEPROM_ASYNC_POLL_WAIT){
+
+		return;
+	}
+
+	if(g_asyncPollTicks == 0){
+
+		/* Write cycle never ended */
+		EEPROM_asyncEnd(EEPROM_NACK);
+		return;
+	}
+
+	g_asyncPollTicks--;
+
+	/* Address only write, ACK means the write cycle ended */
+	g_asyncTransaction.SlaveAddress	= g_writeCycleDevice;
+	g_asyncTransaction.TxBuffer		= NULL_PTR;
+	g_asyncTransaction.TxLength		= 0;
+	g_asyncTransaction.RxBuffer		= NULL_PTR;
+	g_asyncTransaction.RxLength		= 0;
+	g_asyncTransaction.CallBack		= EEPROM_asyncPollDone;
+
+	/* Bus is busy with other transactions, poll again next tick */
+	if(TWI_submitTransaction(&g_asyncTransaction) == TWI_OK){
+
+		g_asyncState		= EEPROM_ASYNC_POLL;
+		g_asyncStallTicks	= EEPROM_WRITE_CYCLE_TICKS;
+	}
 }
 
+#endif /* EEPROM_BACKEND */
@@ -23,8 +23,131 @@
 /*******************************************************************************
  *                      Preprocessor Macros                                    *
  *******************************************************************************/
-#define ERROR 0
-#define SUCCESS 1
+/*
+ * Memory behind the EEPROM functions, selected at compile time
+ * - EEPROM_BACKEND_EXTERNAL: 24Cxx part on the I2C bus (external_eeprom.c), by default
+ * - EEPROM_BACKEND_INTERNAL: On-chip EEPROM of the MCU (internal_eeprom.c), no I2C traffic
+ *   (-DEEPROM_BACKEND=EEPROM_BACKEND_INTERNAL)
+*/
+#define EEPROM_BACKEND_EXTERNAL	(0U)
+#define EEPROM_BACKEND_INTERNAL	(1U)
+
+#ifndef EEPROM_BACKEND
+#define EEPROM_BACKEND			EEPROM_BACKEND_EXTERNAL
+#endif
+
+#if (EEPROM_BACKEND == EEPROM_BACKEND_INTERNAL)
+
+#include <avr/io.h>
+
+/* Memory size in bytes (E2END is the last address of the MCU EEPROM) */
+#define EEPROM_SIZE				(E2END + 1UL)
+
+/*
+ * On-chip EEPROM has no pages, every byte has its own write cycle
+ * EEPROM_writePage accepts bytes of this size blocks so data is laid out
+ * the same way on both memories
+*/
+#define EEPROM_PAGE_SIZE		(16U)
+
+/* Write time of one byte (8.5 ms typical on ATmega16/32) */
+#define EEPROM_WRITE_CYCLE_MS	(9U)
+
+#elif (EEPROM_BACKEND == EEPROM_BACKEND_EXTERNAL)
+
+/* Fastest bus speed supported by 24Cxx EEPROMs (400 kHz at 2.5V and above) */
+#define EEPROM_MAX_BIT_RATE		(400000UL)
+
+/*
+ * Supported 24Cxx parts (Value is the size in Kbit)
+ * Part is selected at compile time (-DEEPROM_DEVICE=EEPROM_24C256 for example), 24C16 by default
+*/
+#define EEPROM_24C01			(1U)
+#define EEPROM_24C02			(2U)
+#define EEPROM_24C04			(4U)
+#define EEPROM_24C08			(8U)
+#define EEPROM_24C16			(16U)
+#define EEPROM_24C32			(32U)
+#define EEPROM_24C64			(64U)
+#define EEPROM_24C128			(128U)
+#define EEPROM_24C256			(256U)
+#define EEPROM_24C512			(512U)
+
+#ifndef EEPROM_DEVICE
+#define EEPROM_DEVICE			EEPROM_24C16
+#endif
+
+/* Level of the A2, A1 and A0 pins of the part (Pins used as address bits are not connected) */
+#ifndef EEPROM_CHIP_SELECT
+#define EEPROM_CHIP_SELECT		(0U)
+#endif
+
+/* Memory size in bytes */
+#define EEPROM_SIZE				(EEPROM_DEVICE * 128UL)
+
+/*
+ * Geometry of the selected part
+ * EEPROM_PAGE_SIZE:			One write cycle writes up to a whole page
+ * EEPROM_WORD_ADDRESS_SIZE:	Bytes of the memory address sent after the device address
+ * 								(Up to 24C16 the address bits above 8 are in the device address)
+*/
+#if (EEPROM_DEVICE == EEPROM_24C01) || (EEPROM_DEVICE == EEPROM_24C02)
+#define EEPROM_PAGE_SIZE			(8U)
+#define EEPROM_WORD_ADDRESS_SIZE	(1U)
+#elif (EEPROM_DEVICE == EEPROM_24C04) || (EEPROM_DEVICE == EEPROM_24C08) || (EEPROM_DEVICE == EEPROM_24C16)
+#define EEPROM_PAGE_SIZE			(16U)
+#define EEPROM_WORD_ADDRESS_SIZE	(1U)
+#elif (EEPROM_DEVICE == EEPROM_24C32) || (EEPROM_DEVICE == EEPROM_24C64)
+#define EEPROM_PAGE_SIZE			(32U)
+#define EEPROM_WORD_ADDRESS_SIZE	(2U)
+#elif (EEPROM_DEVICE == EEPROM_24C128) || (EEPROM_DEVICE == EEPROM_24C256)
+#define EEPROM_PAGE_SIZE			(64U)
+#define EEPROM_WORD_ADDRESS_SIZE	(2U)
+#elif (EEPROM_DEVICE == EEPROM_24C512)
+#define EEPROM_PAGE_SIZE			(128U)
+#define EEPROM_WORD_ADDRESS_SIZE	(2U)
+#else
+#error "EEPROM_DEVICE is not a supported 24Cxx part"
+#endif
+
+/* Longest internal write cycle time (tWR) of 24Cxx EEPROMs, limit of ACK polling */
+#define EEPROM_WRITE_CYCLE_MS	(10U)
+
+/* Time between two ACK polls of an EEPROM in its write cycle */
+#define EEPROM_ACK_POLL_US		(100U)
+
+#else
+#error "EEPROM_BACKEND is not a supported EEPROM backend"
+#endif
+
+/* Period of EEPROM_writeCycleTick, ACK polls of a background write are sent from it */
+#define EEPROM_TICK_MS			(1U)
+
+/* Polls of a background write cycle (One more as the first tick may come at once) */
+#define EEPROM_WRITE_CYCLE_TICKS	( (EEPROM_WRITE_CYCLE_MS / EEPROM_TICK_MS) + 1U )
+
+/*******************************************************************************
+ *                      User Define Data Types                                 *
+ *******************************************************************************/
+
+/********************************************************************************
+
+ [Enumuration Name]:		EEPROM_StatusType
+
+ [Enumuration Description]: Result of an EEPROM access
+
+*********************************************************************************/
+typedef enum{
+
+	EEPROM_OK,
+	EEPROM_NACK,			/* EEPROM did not acknowledge (Absent or its write cycle never ended)	*/
+	EEPROM_BUS_ERROR,		/* Illegal bus condition or arbitration lost					*/
+	EEPROM_TIMEOUT,			/* Bus stuck, it is recovered by TWI_busRecovery				*/
+	EEPROM_PAGE_OVERFLOW,	/* Bytes cross a page boundary (They would wrap to page start)	*/
+	EEPROM_BUSY				/* A background write is still running							*/
+
+}EEPROM_StatusType;
+
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
@@ -63,9 +186,9 @@ void EEPROM_init(void);
 
  [in/out]			None
 
- [Returns]:			Status of writing (SUCCESS if everything is fine)
+ [Returns]:			Status of writing (EEPROM_OK if everything is fine)
 **********************************************************************************/
-uint8 EEPROM_writeByte(uint16 u16addr,uint8 u8data);
+EEPROM_StatusType EEPROM_writeByte(uint16 u16addr,uint8 u8data);
 
 
 /********************************************************************************
@@ -81,9 +204,132 @@ uint8 EEPROM_writeByte(uint16 u16addr,uint8 u8data);
 
  [in/out]			None
 
- [Returns]:			Status of Reading (SUCCESS if everything is fine)
+ [Returns]:			Status of Reading (EEPROM_OK if everything is fine)
+**********************************************************************************/
+EEPROM_StatusType EEPROM_readByte(uint16 u16addr,uint8 *u8data);
+
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_writePage
+
+ [Description]:		Function used to write bytes of one page on EEPROM in one
+ 	 	 	 	 	transaction and one write cycle
+ 	 	 	 	 	(Next access waits for the write cycle by ACK polling)
+
+ [Args]:			u16addr, data, length
+
+ [in]				u16addr: Address of the first byte
+ 	 	 	 	 	data:	 Bytes required to be written
+ 	 	 	 	 	length:	 Number of bytes (They MUST NOT cross the page end)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Status of writing (EEPROM_OK if everything is fine)
+**********************************************************************************/
+EEPROM_StatusType EEPROM_writePage(uint16 u16addr, const uint8 *data, uint8 length);
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_writeBlock
+
+ [Description]:		Function used to write any number of bytes on EEPROM
+ 	 	 	 	 	- Bytes are split at page boundaries, one page write each
+ 	 	 	 	 	- Waits for the write cycle between pages by ACK polling
+ 	 	 	 	 	(Next access waits for the write cycle by ACK polling)
+
+ [Args]:			u16addr, data, length
+
+ [in]				u16addr: Address of the first byte
+ 	 	 	 	 	data:	 Bytes required to be written
+ 	 	 	 	 	length:	 Number of bytes
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Status of writing (EEPROM_OK if everything is fine)
+**********************************************************************************/
+EEPROM_StatusType EEPROM_writeBlock(uint16 u16addr, const uint8 *data, uint16 length);
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_readBlock
+
+ [Description]:		Function used to read number of bytes from EEPROM with one
+ 	 	 	 	 	addressed sequential read (Every byte is ACKed except the last)
+
+ [Args]:			u16addr, data, length
+
+ [in]				u16addr: Address of the first byte
+ 	 	 	 	 	length:	 Number of bytes
+
+ [out]				data:	 Array to save the read bytes on it
+
+ [in/out]			None
+
+ [Returns]:			Status of Reading (EEPROM_OK if everything is fine)
+**********************************************************************************/
+EEPROM_StatusType EEPROM_readBlock(uint16 u16addr, uint8 *data, uint16 length);
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_writeBlockAsync
+
+ [Description]:		Function used to write any number of bytes on EEPROM in the
+ 	 	 	 	 	background without any busy wait
+ 	 	 	 	 	- Every page is one TWI transaction run from TWI ISR
+ 	 	 	 	 	- Its write cycle is ACK polled from EEPROM_writeCycleTick
+ 	 	 	 	 	- Callback is called from the ISR when the last write cycle ends
+ 	 	 	 	 	  or on the first error (At once if length is 0)
+ 	 	 	 	 	- Other EEPROM functions wait for the background write to end
+ 	 	 	 	 	  (Global Interrupts must be enabled, and they must NOT be
+ 	 	 	 	 	  called from ISRs while it is running)
+
+ [Args]:			u16addr, data, length, f_ptr
+
+ [in]				u16addr: Address of the first byte
+ 	 	 	 	 	data:	 Bytes required to be written (MUST stay valid till the callback)
+ 	 	 	 	 	length:	 Number of bytes
+ 	 	 	 	 	f_ptr:	 Pointer to the function called with the result
+ 	 	 	 	 	 	 	 (NULL_PTR if not needed)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			EEPROM_OK if the write started (Result comes to the callback),
+ 	 	 	 	 	EEPROM_BUSY if another background write is running
+**********************************************************************************/
+EEPROM_StatusType EEPROM_writeBlockAsync(uint16 u16addr, const uint8 *data, uint16 length, void (*f_ptr)(EEPROM_StatusType status));
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_writeCycleTick
+
+ [Description]:		Time base of background writes, it should be given as a
+ 	 	 	 	 	callback to a timer which interrupts every EEPROM_TICK_MS
+ 	 	 	 	 	- Sends one ACK poll of the running write cycle every tick
+ 	 	 	 	 	- Write cycle longer than EEPROM_WRITE_CYCLE_MS ends the
+ 	 	 	 	 	  background write with EEPROM_NACK
+ 	 	 	 	 	- Page write or ACK poll queued behind a TWI bus recovery
+ 	 	 	 	 	  (It waits for a TWI call outside ISRs) for longer than
+ 	 	 	 	 	  EEPROM_WRITE_CYCLE_MS ends the background write with
+ 	 	 	 	 	  EEPROM_TIMEOUT
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
 **********************************************************************************/
-uint8 EEPROM_readByte(uint16 u16addr,uint8 *u8data);
+void EEPROM_writeCycleTick(void);
 
 
 #endif /* EXTERNAL_EEPROM_H_ */
@@ -17,11 +17,397 @@
 
 #include "i2c.h"
 
+/* Step of the slowest bit rate (Twice its byte time) must fit the 8 bit tick counter */
+#if ( ( (2UL * TWI_BYTE_TIME_US(16UL + (2UL * 255UL * 64UL))) / (TWI_TIMEOUT_TICK_MS * 1000UL) ) + 2UL ) > 255UL
+#error "Slowest TWI bit rate needs a longer TWI_TIMEOUT_TICK_MS"
+#endif
+
 /*******************************************************************************
  *                           Global Variables                                  *
  *******************************************************************************/
 /* Global Variable to hold address of the call back funtion of TWI Interrupt */
-static volatile void (*g_callBackPtrTWI)(void) = NULL_PTR;
+static void (*volatile g_callBackPtrTWI)(void) = NULL_PTR;
+
+/* Transaction running from TWI ISR (NULL_PTR if the bus is free) */
+static const TWI_TransactionType * volatile g_transactionPtr = NULL_PTR;
+
+/* Index of the next byte to be written or read in the running transaction */
+static volatile uint8 g_transactionIndex = 0;
+
+/* TRUE from the REPEATED START of the read part (Tx bytes are sent) till the transaction ends */
+static volatile uint8 g_transactionReading = FALSE;
+
+/* Transactions waiting behind the running one */
+static const TWI_TransactionType * volatile g_queue[TWI_QUEUE_SIZE];
+
+/* Free running indices of the transaction queue */
+static volatile uint8 g_queueHead = 0;
+static volatile uint8 g_queueTail = 0;
+
+/* Longest wait of one polling step in micro seconds (Set by TWI_init from the bit rate) */
+static uint32 g_timeoutUs = TWI_TIMEOUT_US;
+
+/* Ticks of one transaction step (Set by TWI_init from the bit rate) */
+static uint8 g_stepTicksReload = TWI_TRANSACTION_STEP_TICKS;
+
+/* Remaining ticks of the running transaction step, decremented by TWI_timeoutTick */
+static volatile uint8 g_stepTicks = 0;
+
+/* TRUE from a transaction timeout till TWI_busRecovery runs from thread context (Queue waits for it) */
+static volatile uint8 g_recoveryPending = FALSE;
+
+/* TWEA and TWIE bits kept in TWCR when the bus is released to be addressed as a slave */
+static uint8 g_slaveControl = 0;
+
+/* Global variables to hold the address of the slave register map call back functions */
+static void (*volatile g_callBackPtrSlaveWrite)(uint8 reg, uint8 data) = NULL_PTR;
+static uint8 (*volatile g_callBackPtrSlaveRead)(uint8 reg) = NULL_PTR;
+
+/* Register of the register map accessed by the next byte in slave mode */
+static volatile uint8 g_slaveRegister = 0;
+
+/* TRUE till the register byte of a slave write is received */
+static volatile uint8 g_slaveRegisterPending = FALSE;
+
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Wait for TWINT flag (Bus event is done) at most g_timeoutUs */
+static TWI_StatusType TWI_waitFlag(void){
+
+	uint32 time;
+
+	for(time = 0; BIT_IS_CLEAR(TWCR,TWINT); time++){
+
+		if(time >= g_timeoutUs){
+
+			return TWI_TIMEOUT;
+		}
+
+		_delay_us(1);
+	}
+
+	return TWI_OK;
+}
+
+
+/* Wait for STOP bit to leave the bus (TWSTO is cleared) at most g_timeoutUs */
+static TWI_StatusType TWI_waitStop(void){
+
+	uint32 time;
+
+	for(time = 0; BIT_IS_SET(TWCR,TWSTO); time++){
+
+		if(time >= g_timeoutUs){
+
+			return TWI_TIMEOUT;
+		}
+
+		_delay_us(1);
+	}
+
+	return TWI_OK;
+}
+
+
+/* End a failed polling frame and give the reason of the failure */
+static TWI_StatusType TWI_frameError(void){
+
+	switch(TWI_getStatus()){
+
+	case TW_NO_INFO:
+
+		/* Bus event never ended (TWINT = 0), a slave is holding the bus */
+		(void)TWI_busRecovery();
+		return TWI_TIMEOUT;
+
+	case TW_MT_SLA_W_NACK:
+	case TW_MT_SLA_R_NACK:
+
+		TWI_stop();
+		return TWI_ADDRESS_NACK;
+
+	case TW_MT_DATA_NACK:
+
+		TWI_stop();
+		return TWI_DATA_NACK;
+
+	case TW_ARB_LOST:
+
+		/* Bus is owned by another master, just release it without STOP bit */
+		TWCR = (1 << TWINT) | (1 << TWEN) | g_slaveControl;
+		return TWI_ARBITRATION_LOST;
+
+	default:
+
+		TWI_stop();
+		return TWI_BUS_ERROR;
+	}
+}
+
+
+/* Send START bit of the running transaction, the rest continues in TWI ISR */
+static void TWI_sendStart(void){
+
+	/* STOP bit of the previous transaction must leave the bus first (A stuck bus is caught by TWI_timeoutTick) */
+	(void)TWI_waitStop();
+
+	g_stepTicks = g_stepTicksReload;
+
+	TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+}
+
+
+/*
+ * End the running transaction then call its callback
+ * - Every transaction ends with STOP bit (A 24Cxx drops written bytes without it)
+ * - Next queued transaction takes the bus with START right after the STOP bit
+*/
+static void TWI_endTransaction(TWI_StatusType status){
+
+	/* Pointer to the transaction callback to call it after the bus is given to the next one */
+	void (*callBack)(TWI_StatusType status) = g_transactionPtr->CallBack;
+
+	/* Next transaction starts with its write part */
+	g_transactionReading = FALSE;
+
+	if(status == TWI_TIMEOUT){
+
+		/* Bus is not recovered yet, queued transactions wait for TWI_recoverPending */
+		g_transactionPtr = NULL_PTR;
+	}
+	else if(g_queueHead != g_queueTail){
+
+		g_transactionPtr = g_queue[g_queueTail & TWI_QUEUE_MASK];
+		g_queueTail++;
+
+		g_stepTicks = g_stepTicksReload;
+
+		if(status == TWI_BUS_ERROR){
+
+			/* Only STOP bit recovers from a bus error, then start again */
+			TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWEN) | g_slaveControl;
+			TWI_sendStart();
+		}
+		else if(status == TWI_ARBITRATION_LOST){
+
+			/* Bus is owned by another master, START as soon as it is free (No STOP bit) */
+			TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+		}
+		else{
+
+			/* STOP bit then START (TWI Module sends both, TW_START comes after them) */
+			TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+		}
+	}
+	else{
+
+		if(status == TWI_ARBITRATION_LOST){
+
+			/* Bus is owned by another master, just release it without STOP bit */
+			TWCR = (1 << TWINT) | (1 << TWEN) | g_slaveControl;
+		}
+		else{
+
+			/* Send STOP bit and disable TWI Interrupt (Unless it is needed by slave mode) */
+			TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWEN) | g_slaveControl;
+		}
+
+		g_transactionPtr = NULL_PTR;
+	}
+
+	if(callBack != NULL_PTR){
+
+		(*callBack)(status);
+	}
+}
+
+
+/* Move the running transaction one step, called from TWI ISR after every bus event */
+static void TWI_transactionStep(void){
+
+	const TWI_TransactionType *transaction = g_transactionPtr;
+
+	switch(TWI_getStatus()){
+
+	case TW_START:
+	case TW_REP_START:
+
+		if(g_transactionReading == TRUE){
+
+			/* REPEATED START of the read part, Tx bytes are sent already */
+			TWDR = (uint8)( (transaction->SlaveAddress << 1) | 1 );
+		}
+		else if( (transaction->TxLength > 0) || (transaction->RxLength == 0) ){
+
+			/* Write part first (Also a write with no bytes is used to probe the slave) */
+			g_transactionIndex = 0;
+
+			TWDR = (uint8)(transaction->SlaveAddress << 1);
+		}
+		else{
+
+			/* Read only transaction */
+			g_transactionIndex		= 0;
+			g_transactionReading	= TRUE;
+
+			TWDR = (uint8)( (transaction->SlaveAddress << 1) | 1 );
+		}
+
+		TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+		break;
+
+	case TW_MT_SLA_W_ACK:
+	case TW_MT_DATA_ACK:
+
+		if(g_transactionIndex < transaction->TxLength){
+
+			TWDR = transaction->TxBuffer[g_transactionIndex];
+			g_transactionIndex++;
+
+			TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+		}
+		else if(transaction->RxLength > 0){
+
+			/* Repeated start to turn the bus direction to read, Rx bytes are counted from 0 */
+			g_transactionIndex		= 0;
+			g_transactionReading	= TRUE;
+
+			TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+		}
+		else{
+
+			TWI_endTransaction(TWI_OK);
+		}
+		break;
+
+	case TW_MR_DATA_ACK:
+
+		transaction->RxBuffer[g_transactionIndex] = TWDR;
+		g_transactionIndex++;
+
+		/* Falls through - decide ACK or NACK of the next byte */
+
+	case TW_MT_SLA_R_ACK:
+
+		if( (uint8)(g_transactionIndex + 1) < transaction->RxLength ){
+
+			/* More bytes are needed after the next one, so ACK it */
+			TWCR = (1 << TWINT) | (1 << TWEA) | (1 << TWEN) | (1 << TWIE);
+		}
+		else{
+
+			/* Next byte is the last one, so NACK it */
+			TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+		}
+		break;
+
+	case TW_MR_DATA_NACK:
+
+		transaction->RxBuffer[g_transactionIndex] = TWDR;
+		g_transactionIndex++;
+
+		TWI_endTransaction(TWI_OK);
+		break;
+
+	case TW_MT_SLA_W_NACK:
+	case TW_MT_SLA_R_NACK:
+
+		TWI_endTransaction(TWI_ADDRESS_NACK);
+		break;
+
+	case TW_MT_DATA_NACK:
+
+		TWI_endTransaction(TWI_DATA_NACK);
+		break;
+
+	case TW_ARB_LOST:
+
+		TWI_endTransaction(TWI_ARBITRATION_LOST);
+		break;
+
+	default:
+
+		TWI_endTransaction(TWI_BUS_ERROR);
+		break;
+	}
+}
+
+
+/* Serve one bus event of slave mode with the register map callbacks */
+static void TWI_slaveStep(uint8 status){
+
+	/* START of a master transaction which lost arbitration is sent again when the bus is free */
+	uint8 restart = ( (g_transactionPtr != NULL_PTR) ? (1 << TWSTA) : 0 );
+
+	uint8 data;
+
+	if( (restart != 0) && ( (status == TW_SR_ARB_LOST_SLA_ACK) || (status == TW_SR_ARB_LOST_GCALL_ACK) || (status == TW_ST_ARB_LOST_SLA_ACK) ) ){
+
+		/*
+		 * Arbitration may be lost on the SLA+R of the read part, the restart
+		 * sends the whole transaction again so the register address is rewritten
+		*/
+		g_transactionReading	= FALSE;
+		g_transactionIndex		= 0;
+	}
+
+	switch(status){
+
+	case TW_SR_SLA_ACK:
+	case TW_SR_ARB_LOST_SLA_ACK:
+	case TW_SR_GCALL_ACK:
+	case TW_SR_ARB_LOST_GCALL_ACK:
+
+		/* Master writes, first byte is the register */
+		g_slaveRegisterPending = TRUE;
+
+		TWCR = (1 << TWINT) | (1 << TWEA) | (1 << TWEN) | (1 << TWIE);
+		break;
+
+	case TW_SR_DATA_ACK:
+	case TW_SR_GCALL_DATA_ACK:
+
+		data = TWDR;
+
+		if(g_slaveRegisterPending == TRUE){
+
+			g_slaveRegister			= data;
+			g_slaveRegisterPending	= FALSE;
+		}
+		else{
+
+			if(g_callBackPtrSlaveWrite != NULL_PTR){
+
+				(*g_callBackPtrSlaveWrite)(g_slaveRegister, data);
+			}
+
+			g_slaveRegister++;
+		}
+
+		TWCR = (1 << TWINT) | (1 << TWEA) | (1 << TWEN) | (1 << TWIE);
+		break;
+
+	case TW_ST_SLA_ACK:
+	case TW_ST_ARB_LOST_SLA_ACK:
+	case TW_ST_DATA_ACK:
+
+		/* Master reads from the selected register */
+		TWDR = ( (g_callBackPtrSlaveRead != NULL_PTR) ? (*g_callBackPtrSlaveRead)(g_slaveRegister) : 0xFF );
+		g_slaveRegister++;
+
+		TWCR = (1 << TWINT) | (1 << TWEA) | (1 << TWEN) | (1 << TWIE);
+		break;
+
+	default:
+
+		/* Frame ended (STOP, REPEATED START or NACK of the master), wait to be addressed again */
+		TWCR = (1 << TWINT) | (1 << TWEA) | (1 << TWEN) | (1 << TWIE) | restart;
+		break;
+	}
+}
 
 
 /*******************************************************************************
@@ -29,6 +415,35 @@ static volatile void (*g_callBackPtrTWI)(void) = NULL_PTR;
  *******************************************************************************/
 ISR(TWI_vect){
 
+	uint8 status = TWI_getStatus();
+
+	/* Addressed as a slave (Also if a running transaction lost arbitration to this address) */
+	if( (g_slaveControl != 0) && (status >= TW_SR_SLA_ACK) && (status <= TW_ST_LAST_DATA) ){
+
+		/* Bus is busy with the slave frame, a master transaction waiting to restart must not time out */
+		g_stepTicks = g_stepTicksReload;
+
+		TWI_slaveStep(status);
+		return;
+	}
+
+	/* Running transaction owns the interrupt */
+	if(g_transactionPtr != NULL_PTR){
+
+		/* Bus event came in time, count the next step from now */
+		g_stepTicks = g_stepTicksReload;
+
+		TWI_transactionStep();
+		return;
+	}
+
+	/* Late bus event of a timed out transaction, release the bus till it is recovered */
+	if(g_recoveryPending == TRUE){
+
+		TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWEN) | g_slaveControl;
+		return;
+	}
+
 	/*
 	 * Check if the Pointer not a Null one
 	 * To avoid segmentation fault
@@ -50,7 +465,10 @@ ISR(TWI_vect){
  [Function Name]:	TWI_init
 
  [Description]:		Used to initialize I2C Module
- 	 	 	 	 	- 1 pre-scaler to ease bit rate calculations
+ 	 	 	 	 	- TWBR and TWPS are chosen together to get the fastest bit rate
+ 	 	 	 	 	  not above the required one (TWBR >= TWI_TWBR_MIN)
+ 	 	 	 	 	- Polling and transaction step timeouts are made twice
+ 	 	 	 	 	  the byte time of a slow bit rate
  	 	 	 	 	- Initiate with device address (If not a microcontroller or master)
  	 	 	 	 	  if master, its address will be 0x01
  	 	 	 	 	- Enable I2C Module
@@ -67,37 +485,73 @@ ISR(TWI_vect){
 **********************************************************************************/
 void TWI_init(const TWI_ConfigType* config_Ptr){
 
-	uint8 bitRateCalculation;
+	/* Value of (2 * TWBR * 4^TWPS) needed for the required bit rate */
+	uint32 divider;
+
+	/* TWBR value for the current prescaler */
+	uint32 bitRate;
+
+	/* Time of one byte at the generated bit rate in micro seconds */
+	uint32 byteTime;
+
+	/* Prescaler bits TWPS (Prescaler value is 4^TWPS) */
+	uint8 prescaler = 0;
+
 	/* Clear all registers before doing  anything */
 	TWBR &= 0x00;
 	TWCR &= 0x00;
 	TWDR &= 0x00;
 	TWAR &= 0x00;
 
-	/* Bit rate calculations */
-	bitRateCalculation = ( ( (F_CPU) - ( (config_Ptr -> BitRate) * 16) ) / (2 * (config_Ptr -> BitRate) ) );
+	/*
+	 * Bit rate calculations, rounded up so SCL is never faster than required
+	 * (It was saved in uint8 before so the check of negative values never worked)
+	*/
+	if( (config_Ptr -> BitRate) >= TWI_MAX_BIT_RATE ){
 
-	/* Check if number is Bigger than zero or not */
-	if(bitRateCalculation >= 0){
+		/* Fastest rate of this F_CPU */
+		divider = 2UL * TWI_TWBR_MIN;
+	}
+	else if( (config_Ptr -> BitRate) <= TWI_MIN_BIT_RATE ){
 
-		/*Bit Rate calculation proper with this clock*/
-		TWBR = bitRateCalculation;
+		/* Slowest rate of this F_CPU */
+		divider = 2UL * 255UL * 64UL;
 	}
+	else{
 
-	/*
-	 * Check if BitRate calculation value < 0
-	 * Also check if processor clock is bigger than 1 MHz
-	 * which is the proper one for calculations here
-	*/
-	else if ( (F_CPU > 1000000) && (bitRateCalculation < 0) )
-	{
-		/* Reduce BitRate to Normal Mode  */
-		bitRateCalculation = ( ( (F_CPU) - ( (NORMAL_MODE_100KB) * 16) ) / (2 * (NORMAL_MODE_100KB) ) );
-		TWBR = bitRateCalculation;
+		divider = ( ( (F_CPU) + (config_Ptr -> BitRate) - 1UL ) / (config_Ptr -> BitRate) ) - 16UL;
+	}
+
+	/* Smallest prescaler which keeps TWBR in 8 bits gives the most accurate rate */
+	bitRate = (divider + 1UL) >> 1;
+
+	while( (bitRate > 255UL) && (prescaler < 3U) ){
+
+		prescaler++;
+
+		/* Divide by 2 * 4^TWPS, rounded up */
+		bitRate = ( divider + (1UL << (1U + (2U * prescaler))) - 1UL ) >> (1U + (2U * prescaler));
+	}
+
+	TWBR = (uint8)bitRate;
+
+	/* Prescaler in TWPS1:0, status bits are read only */
+	TWSR = prescaler;
+
+	/* Twice the byte time of the generated SCL (16 + 2 * TWBR * 4^TWPS cycles) is the least wait of one step */
+	byteTime = TWI_BYTE_TIME_US( 16UL + (bitRate << (1U + (2U * prescaler))) );
+
+	g_timeoutUs = ( ( (2UL * byteTime) > TWI_TIMEOUT_US ) ? (2UL * byteTime) : TWI_TIMEOUT_US );
+
+	if( (2UL * byteTime) > (TWI_TRANSACTION_STEP_TIMEOUT_MS * 1000UL) ){
+
+		/* Rounded up to whole ticks, one more tick as the first one may come at once */
+		g_stepTicksReload = (uint8)( ( ( (2UL * byteTime) + (TWI_TIMEOUT_TICK_MS * 1000UL) - 1UL ) / (TWI_TIMEOUT_TICK_MS * 1000UL) ) + 1UL );
 	}
+	else{
 
-	/* Zero Prescaler */
-	TWSR = 0x00;
+		g_stepTicksReload = TWI_TRANSACTION_STEP_TICKS;
+	}
 
     /*
      * Two Wire Bus address my address
@@ -107,11 +561,15 @@ void TWI_init(const TWI_ConfigType* config_Ptr){
     */
     TWAR = ( (config_Ptr -> Address) & 0xFE);
 
-    /* Choose Operating mode (Interrupt or polling) */
-    TWCR = ( (config_Ptr -> InterruptMode) );
+    /* Slave mode acknowledges its address and is served from TWI ISR */
+    g_slaveControl = ( ( (config_Ptr -> SlaveMode) == SLAVE_MODE_ENABLE ) ? ( (1 << TWEA) | (1 << TWIE) ) : 0 );
 
-    /* Enable TWI Module */
-    TWCR = (1<<TWEN);
+    /*
+     * Enable TWI Module
+     * Choose Operating mode (Interrupt or polling), TWIE is bit 0 so
+     * INTERRUPT_MODE_ENABLE sets it (It was overwritten by TWEN before)
+    */
+    TWCR = (1<<TWEN) | ( ( (config_Ptr -> InterruptMode) & 0x01 ) << TWIE ) | g_slaveControl;
 
 }
 
@@ -121,6 +579,7 @@ void TWI_init(const TWI_ConfigType* config_Ptr){
  [Function Name]:	TWI_start
 
  [Description]:		Used to send start bit on I2C Frame
+ 	 	 	 	 	(Waits at most one step timeout for the bus)
 
  [Args]:			None
 
@@ -130,9 +589,9 @@ void TWI_init(const TWI_ConfigType* config_Ptr){
 
  [in/out]			None
 
- [Returns]:			None
+ [Returns]:			TWI_OK if the start bit is sent, TWI_TIMEOUT otherwise
 **********************************************************************************/
-void TWI_start(void){
+TWI_StatusType TWI_start(void){
 
     /*
 	 * - Clear the TWINT flag before sending the start bit TWINT=1
@@ -142,7 +601,7 @@ void TWI_start(void){
     TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN);
 
     /* Wait for TWINT flag set in TWCR Register (start bit is send successfully) */
-    while(BIT_IS_CLEAR(TWCR,TWINT));
+    return TWI_waitFlag();
 }
 
 
@@ -169,7 +628,7 @@ void TWI_stop(void){
 	 * - send the stop bit by TWSTO=1
 	 * - Enable TWI Module TWEN=1
 	 */
-    TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWEN);
+    TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWEN) | g_slaveControl;
 }
 
 
@@ -177,6 +636,7 @@ void TWI_stop(void){
  [Function Name]:	TWI_write
 
  [Description]:		Used to write data/address on I2C Frame
+ 	 	 	 	 	(Waits at most one step timeout for the byte)
 
  [Args]:			data
 
@@ -184,11 +644,11 @@ void TWI_stop(void){
 
  [out]				None
 
- [in/out]]			None
+ [in/out]			None
 
- [Returns]:]		None
+ [Returns]:			TWI_OK if the byte is sent, TWI_TIMEOUT otherwise
 **********************************************************************************/
-void TWI_write(uint8 data){
+TWI_StatusType TWI_write(uint8 data){
 
 	/* Put data On TWI data Register */
     TWDR = data;
@@ -200,7 +660,7 @@ void TWI_write(uint8 data){
     TWCR = (1 << TWINT) | (1 << TWEN);
 
     /* Wait for TWINT flag set in TWCR Register(data is send successfully) */
-    while(BIT_IS_CLEAR(TWCR,TWINT));
+    return TWI_waitFlag();
 }
 
 
@@ -209,6 +669,8 @@ void TWI_write(uint8 data){
  [Function Name]:	TWI_readWithACK
 
  [Description]:		Perform a read operation with sending ACK
+ 	 	 	 	 	(Waits at most one step timeout, TWI_getStatus gives
+ 	 	 	 	 	TW_NO_INFO if no byte is received)
 
  [Args]:			None
 
@@ -230,7 +692,7 @@ uint8 TWI_readWithACK(void){
     TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWEA);
 
     /* Wait for TWINT flag set in TWCR Register (data received successfully) */
-    while(BIT_IS_CLEAR(TWCR,TWINT));
+    (void)TWI_waitFlag();
 
     /* Read Data */
     return TWDR;
@@ -242,6 +704,8 @@ uint8 TWI_readWithACK(void){
  [Function Name]:	TWI_readWithNACK
 
  [Description]:		Perform a read operation without sending ACK
+ 	 	 	 	 	(Waits at most one step timeout, TWI_getStatus gives
+ 	 	 	 	 	TW_NO_INFO if no byte is received)
 
  [Args]:			None
 
@@ -262,7 +726,7 @@ uint8 TWI_readWithNACK(void){
     TWCR = (1 << TWINT) | (1 << TWEN);
 
     /* Wait for TWINT flag set in TWCR Register (data received successfully) */
-    while(BIT_IS_CLEAR(TWCR,TWINT));
+    (void)TWI_waitFlag();
 
     /* Read Data */
     return TWDR;
@@ -315,3 +779,537 @@ uint8 TWI_getStatus(void){
 void TWI_setCallBack(void (*f_ptr)(void)){
 	g_callBackPtrTWI = f_ptr;
 }
+
+
+
+/********************************************************************************
+ [Function Name]:	TWI_setSlaveWriteCallBack
+
+ [Description]:		Function Callback called from TWI ISR in slave mode for every
+ 	 	 	 	 	byte written by the master to the register map
+ 	 	 	 	 	- First byte after the address selects the register
+ 	 	 	 	 	- Next bytes are written to this register and the following ones
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to function which takes the register and the byte
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void TWI_setSlaveWriteCallBack(void (*f_ptr)(uint8 reg, uint8 data)){
+	g_callBackPtrSlaveWrite = f_ptr;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	TWI_setSlaveReadCallBack
+
+ [Description]:		Function Callback called from TWI ISR in slave mode for every
+ 	 	 	 	 	byte read by the master from the register map
+ 	 	 	 	 	- Reading starts from the last selected register and
+ 	 	 	 	 	  goes to the following ones
+ 	 	 	 	 	- 0xFF is sent if no callback is set
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to function which returns the byte of a register
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void TWI_setSlaveReadCallBack(uint8 (*f_ptr)(uint8 reg)){
+	g_callBackPtrSlaveRead = f_ptr;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	TWI_startTransaction
+
+ [Description]:		Used to start a whole master transaction which continues
+ 	 	 	 	 	in TWI ISR without any busy wait, the callback of the
+ 	 	 	 	 	transaction is called after the STOP bit
+ 	 	 	 	 	(Global Interrupts must be enabled)
+
+ [Args]:			transaction_Ptr
+
+ [in]				transaction_Ptr: Pointer to the transaction structure
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			TWI_OK if the transaction started, TWI_BUSY if a previous
+ 	 	 	 	 	transaction is still running (Or the bus recovery after
+ 	 	 	 	 	a timeout waits for a call from outside ISRs)
+**********************************************************************************/
+TWI_StatusType TWI_startTransaction(const TWI_TransactionType* transaction_Ptr){
+
+	uint8 sreg = SREG;
+
+	/* Bus recovery of a timed out transaction is done only from thread context */
+	if(BIT_IS_SET(sreg,7)){
+
+		TWI_recoverPending();
+	}
+
+	cli();
+
+	if( (g_transactionPtr != NULL_PTR) || (g_recoveryPending == TRUE) ){
+
+		SREG = sreg;
+		return TWI_BUSY;
+	}
+
+	g_transactionPtr = transaction_Ptr;
+
+	SREG = sreg;
+
+	TWI_sendStart();
+
+	return TWI_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	TWI_submitTransaction
+
+ [Description]:		Used to add a master transaction to the transaction queue
+ 	 	 	 	 	- Starts at once if the bus is free
+ 	 	 	 	 	- Otherwise it starts from TWI ISR right after the running one
+ 	 	 	 	 	  with STOP then START (No idle bus time, STOP lets a 24Cxx
+ 	 	 	 	 	  commit the bytes written by the running one)
+ 	 	 	 	 	- Transactions run in the order they are submitted
+ 	 	 	 	 	- Bus recovery after a timeout is done here if it is called
+ 	 	 	 	 	  outside ISRs (From ISRs the transaction is queued behind it)
+ 	 	 	 	 	(Global Interrupts must be enabled)
+
+ [Args]:			transaction_Ptr
+
+ [in]				transaction_Ptr: Pointer to the transaction structure
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			TWI_OK if the transaction is started or queued,
+ 	 	 	 	 	TWI_BUSY if the queue is full
+**********************************************************************************/
+TWI_StatusType TWI_submitTransaction(const TWI_TransactionType* transaction_Ptr){
+
+	uint8 sreg = SREG;
+
+	/* Bus recovery of a timed out transaction is done only from thread context */
+	if(BIT_IS_SET(sreg,7)){
+
+		TWI_recoverPending();
+	}
+
+	cli();
+
+	/* Bus is free, start it now (Otherwise it waits behind the bus recovery) */
+	if( (g_transactionPtr == NULL_PTR) && (g_recoveryPending == FALSE) ){
+
+		g_transactionPtr = transaction_Ptr;
+
+		SREG = sreg;
+
+		TWI_sendStart();
+
+		return TWI_OK;
+	}
+
+	if( (uint8)(g_queueHead - g_queueTail) >= TWI_QUEUE_SIZE ){
+
+		SREG = sreg;
+		return TWI_BUSY;
+	}
+
+	/* Taken by TWI ISR when the running transaction ends */
+	g_queue[g_queueHead & TWI_QUEUE_MASK] = transaction_Ptr;
+	g_queueHead++;
+
+	SREG = sreg;
+
+	return TWI_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	TWI_isBusy
+
+ [Description]:		Used to know if a transaction is running on the bus
+ 	 	 	 	 	(Or waiting in the transaction queue, or for the bus
+ 	 	 	 	 	recovery after a timeout)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			TRUE if a transaction is running, FALSE otherwise
+**********************************************************************************/
+uint8 TWI_isBusy(void){
+
+	return ( ( (g_transactionPtr != NULL_PTR) || (g_recoveryPending == TRUE) ) ? TRUE : FALSE );
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	TWI_recoverPending
+
+ [Description]:		Used to recover the bus after a transaction timeout, then
+ 	 	 	 	 	start the transactions queued behind it (Nothing to do if
+ 	 	 	 	 	no recovery is pending)
+ 	 	 	 	 	- TWI_transfer, TWI_startTransaction and TWI_submitTransaction
+ 	 	 	 	 	  call it already when they are called outside ISRs
+ 	 	 	 	 	(MUST NOT be called from ISRs, TWI_busRecovery busy waits)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void TWI_recoverPending(void){
+
+	uint8 sreg;
+
+	if(g_recoveryPending == FALSE){
+
+		return;
+	}
+
+	(void)TWI_busRecovery();
+
+	sreg = SREG;
+
+	cli();
+
+	g_recoveryPending = FALSE;
+
+	if( (g_transactionPtr == NULL_PTR) && (g_queueHead != g_queueTail) ){
+
+		g_transactionPtr = g_queue[g_queueTail & TWI_QUEUE_MASK];
+		g_queueTail++;
+
+		SREG = sreg;
+
+		TWI_sendStart();
+		return;
+	}
+
+	SREG = sreg;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	TWI_isRecoveryPending
+
+ [Description]:		Used to know if the bus recovery after a transaction timeout
+ 	 	 	 	 	waits for a TWI call from outside ISRs (Queued transactions
+ 	 	 	 	 	do not start till then)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			TRUE if the bus recovery is pending, FALSE otherwise
+**********************************************************************************/
+uint8 TWI_isRecoveryPending(void){
+
+	return g_recoveryPending;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	TWI_cancelTransaction
+
+ [Description]:		Used to remove a transaction from the transaction queue
+ 	 	 	 	 	before it starts (Its callback is NOT called), so its
+ 	 	 	 	 	buffers and structure can be used again
+
+ [Args]:			transaction_Ptr
+
+ [in]				transaction_Ptr: Pointer to the queued transaction structure
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			TWI_OK if the transaction was removed, TWI_BUSY if it is
+ 	 	 	 	 	running (Or not queued)
+**********************************************************************************/
+TWI_StatusType TWI_cancelTransaction(const TWI_TransactionType* transaction_Ptr){
+
+	uint8 sreg = SREG;
+
+	/* Queue index */
+	uint8 i;
+
+	cli();
+
+	for(i = g_queueTail; i != g_queueHead; i++){
+
+		if(g_queue[i & TWI_QUEUE_MASK] == transaction_Ptr){
+
+			/* Transactions behind it move one place forward (Order is kept) */
+			for(i++; i != g_queueHead; i++){
+
+				g_queue[(uint8)(i - 1U) & TWI_QUEUE_MASK] = g_queue[i & TWI_QUEUE_MASK];
+			}
+
+			g_queueHead--;
+
+			SREG = sreg;
+			return TWI_OK;
+		}
+	}
+
+	SREG = sreg;
+
+	return TWI_BUSY;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	TWI_timeoutTick
+
+ [Description]:		Time base of TWI transaction timeouts, it should be given as
+ 	 	 	 	 	a callback to a timer which interrupts every TWI_TIMEOUT_TICK_MS
+ 	 	 	 	 	- A stuck transaction ends with TWI_TIMEOUT, no busy wait here
+ 	 	 	 	 	- Bus is recovered later by the next TWI_transfer, or
+ 	 	 	 	 	  TWI_startTransaction/TWI_submitTransaction called outside
+ 	 	 	 	 	  ISRs, then the queued transactions start
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void TWI_timeoutTick(void){
+
+	if( (g_transactionPtr != NULL_PTR) && (g_stepTicks > 0) ){
+
+		g_stepTicks--;
+
+		if(g_stepTicks == 0){
+
+			/*
+			 * No bus event for a whole step, end the transaction and stop the master
+			 * operation, slave mode bits are kept so this node is still addressable
+			 * (Bus recovery busy waits, so it runs later from thread context)
+			*/
+			g_recoveryPending = TRUE;
+
+			TWCR = (1 << TWEN) | g_slaveControl;
+
+			TWI_endTransaction(TWI_TIMEOUT);
+		}
+	}
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	TWI_busRecovery
+
+ [Description]:		Used to free the bus if a slave holds SDA low
+ 	 	 	 	 	(Reset in the middle of a read for example)
+ 	 	 	 	 	- TWI is disabled and SCL is clocked by hand up to 9 times
+ 	 	 	 	 	  till the slave releases SDA
+ 	 	 	 	 	- STOP condition is sent by hand then TWI is enabled again
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			TWI_OK if the bus is free, TWI_BUS_ERROR if SDA is still low
+**********************************************************************************/
+TWI_StatusType TWI_busRecovery(void){
+
+	/* Interrupt and acknowledge bits (Slave mode) are given back at the end */
+	uint8 control = TWCR & ( (1 << TWEA) | (1 << TWIE) );
+
+	/* SDA level after the recovery */
+	uint8 sdaFree;
+
+	/* Number of SCL pulses sent */
+	uint8 pulse;
+
+	/* Disable TWI Module so SCL and SDA are normal I/O pins */
+	TWCR = 0x00;
+
+	/*
+	 * Lines are open drain: released line is an input pulled up by the bus,
+	 * driven line is an output with zero
+	*/
+	CLEAR_BIT(TWI_PORT,TWI_SCL);
+	CLEAR_BIT(TWI_PORT,TWI_SDA);
+	CLEAR_BIT(TWI_DDR,TWI_SCL);
+	CLEAR_BIT(TWI_DDR,TWI_SDA);
+	_delay_us(5);
+
+	/* Clock SCL (100 kHz) till the slave ends its byte and releases SDA */
+	for(pulse = 0; (pulse < 9U) && BIT_IS_CLEAR(TWI_PIN,TWI_SDA); pulse++){
+
+		SET_BIT(TWI_DDR,TWI_SCL);
+		_delay_us(5);
+
+		CLEAR_BIT(TWI_DDR,TWI_SCL);
+		_delay_us(5);
+	}
+
+	/* STOP condition: SDA goes from low to high while SCL is high */
+	SET_BIT(TWI_DDR,TWI_SCL);
+	_delay_us(5);
+
+	SET_BIT(TWI_DDR,TWI_SDA);
+	_delay_us(5);
+
+	CLEAR_BIT(TWI_DDR,TWI_SCL);
+	_delay_us(5);
+
+	CLEAR_BIT(TWI_DDR,TWI_SDA);
+	_delay_us(5);
+
+	sdaFree = BIT_IS_SET(TWI_PIN,TWI_SDA);
+
+	/* Give the pins back to TWI Module */
+	TWCR = (1 << TWEN) | control | g_slaveControl;
+
+	return ( sdaFree ? TWI_OK : TWI_BUS_ERROR );
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	TWI_transfer
+
+ [Description]:		Used to run a whole master transaction with busy wait:
+ 	 	 	 	 	START, SLA+W, Tx bytes, REPEATED START, SLA+R, Rx bytes, STOP
+ 	 	 	 	 	- Write part is skipped if txLength is 0
+ 	 	 	 	 	- Read part is skipped if rxLength is 0
+ 	 	 	 	 	- Every Rx byte is ACKed except the last one
+ 	 	 	 	 	- Frame is ended with STOP on any error (Stuck bus is recovered)
+ 	 	 	 	 	- Recovers the bus after a transaction timeout, then waits
+ 	 	 	 	 	  for the queued transactions to end first
+
+ [Args]:			address, txBuffer, txLength, rxBuffer, rxLength
+
+ [in]				address:  7 bits address of the slave (Without R/W bit)
+ 	 	 	 	 	txBuffer: Bytes written to the slave
+ 	 	 	 	 	txLength: Number of bytes written to the slave
+ 	 	 	 	 	rxLength: Number of bytes read from the slave
+
+ [out]				rxBuffer: Array to save the bytes read from the slave
+
+ [in/out]			None
+
+ [Returns]:			TWI_OK if everything is fine, otherwise the reason of the failure
+**********************************************************************************/
+TWI_StatusType TWI_transfer(uint8 address, const uint8 *txBuffer, uint8 txLength, uint8 *rxBuffer, uint8 rxLength){
+
+	uint8 i;
+
+	/* Bus recovery of a timed out transaction (It starts the queued transactions) */
+	TWI_recoverPending();
+
+	/* Queued transactions own the bus till they end */
+	while(TWI_isBusy()){}
+
+	/* Send start bit to start I2C Frame */
+	if( (TWI_start() != TWI_OK) || (TWI_getStatus() != TW_START) ){
+
+		return TWI_frameError();
+	}
+
+	/* Write part (Also a write with no bytes is used to probe the slave) */
+	if( (txLength > 0) || (rxLength == 0) ){
+
+		if( (TWI_write((uint8)(address << 1)) != TWI_OK) || (TWI_getStatus() != TW_MT_SLA_W_ACK) ){
+
+			return TWI_frameError();
+		}
+
+		for(i = 0; i < txLength; i++){
+
+			if( (TWI_write(txBuffer[i]) != TWI_OK) || (TWI_getStatus() != TW_MT_DATA_ACK) ){
+
+				return TWI_frameError();
+			}
+		}
+
+		/* Repeated start to turn the bus direction to read */
+		if( (rxLength > 0) && ( (TWI_start() != TWI_OK) || (TWI_getStatus() != TW_REP_START) ) ){
+
+			return TWI_frameError();
+		}
+	}
+
+	/* Read part */
+	if(rxLength > 0){
+
+		if( (TWI_write((uint8)( (address << 1) | 1 )) != TWI_OK) || (TWI_getStatus() != TW_MT_SLA_R_ACK) ){
+
+			return TWI_frameError();
+		}
+
+		/* All bytes are ACKed except the last one, so the slave stops sending */
+		for(i = 0; i < (uint8)(rxLength - 1); i++){
+
+			rxBuffer[i] = TWI_readWithACK();
+
+			if(TWI_getStatus() != TW_MR_DATA_ACK){
+
+				return TWI_frameError();
+			}
+		}
+
+		rxBuffer[i] = TWI_readWithNACK();
+
+		if(TWI_getStatus() != TW_MR_DATA_NACK){
+
+			return TWI_frameError();
+		}
+	}
+
+	/* Sending Stop bit to end the frame */
+	TWI_stop();
+
+	return TWI_OK;
+}
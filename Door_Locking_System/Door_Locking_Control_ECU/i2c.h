@@ -34,9 +34,73 @@
 #define INTERRUPT_MODE_ENABLE		(1U)
 #define INTERRUPT_MODE_DISABLE		(0U)
 
-/* Preprocessor macros for MC Address if it is in slave mode */
+/* Preprocessor macros for Slave Mode */
+#define SLAVE_MODE_ENABLE			(1U)
+#define SLAVE_MODE_DISABLE			(0U)
+
+/* Preprocessor macros for MC Address if it is in slave mode (7 bits address 0x01 in TWAR format) */
 #define ADDRESS_OF_MC_IN_SLAVE_MODE	((0x02))
 
+/*
+ * SCL frequency = F_CPU / (16 + 2 * TWBR * 4^TWPS)
+ * TWBR should be 10 or higher in master mode, otherwise the master
+ * may put wrong values on SDA and SCL
+*/
+#define TWI_TWBR_MIN				(10UL)
+
+/* Fastest and slowest SCL frequency the master can generate with this F_CPU */
+#define TWI_MAX_BIT_RATE			( (F_CPU) / (16UL + (2UL * TWI_TWBR_MIN)) )
+#define TWI_MIN_BIT_RATE			( (F_CPU) / (16UL + (2UL * 255UL * 64UL)) )
+
+/* Fastest SCL frequency not above the one a device supports */
+#define TWI_FASTEST_BIT_RATE(DEVICE_RATE)	( ((DEVICE_RATE) < TWI_MAX_BIT_RATE) ? (DEVICE_RATE) : TWI_MAX_BIT_RATE )
+
+/* Check at compile time that a bit rate can be generated (Use it in #if) */
+#define TWI_BIT_RATE_VALID(RATE)	( ((RATE) >= TWI_MIN_BIT_RATE) && ((RATE) <= TWI_MAX_BIT_RATE) )
+
+#if (TWI_MAX_BIT_RATE < TWI_MIN_BIT_RATE)
+#error "F_CPU is too slow for TWI master mode"
+#endif
+
+/* TWI pins on ATmega16/32, driven by hand in TWI_busRecovery */
+#define TWI_PORT					PORTC
+#define TWI_DDR						DDRC
+#define TWI_PIN						PINC
+#define TWI_SCL						PC0
+#define TWI_SDA						PC1
+
+/* Time of one byte and its ACK (9 SCL periods) in micro seconds, SCL period given in CPU cycles */
+#define TWI_BYTE_TIME_US(SCL_CYCLES)	( ( (9UL * (SCL_CYCLES) * 1000UL) + ((F_CPU) / 1000UL) - 1UL ) / ((F_CPU) / 1000UL) )
+
+/*
+ * Shortest wait of one polling step (START, one byte or STOP) in micro seconds
+ * TWI_init makes it twice the byte time when the bit rate is slower
+*/
+#define TWI_TIMEOUT_US				(1000U)
+
+/*
+ * Transactions run from TWI ISR are timed by TWI_timeoutTick
+ * A transaction is aborted if one bus event takes more than TWI_TRANSACTION_STEP_TIMEOUT_MS
+ * (TWI_init makes the step twice the byte time when the bit rate is slower)
+*/
+#define TWI_TIMEOUT_TICK_MS					(1U)
+#define TWI_TRANSACTION_STEP_TIMEOUT_MS		(2U)
+
+/* Ticks of one step at a fast bit rate (One more tick as the first one may come at once) */
+#define TWI_TRANSACTION_STEP_TICKS			( (TWI_TRANSACTION_STEP_TIMEOUT_MS / TWI_TIMEOUT_TICK_MS) + 1U )
+
+/*
+ * Number of transactions waiting behind the running one in the transaction queue
+ * It MUST be a power of 2 and not bigger than 128 as the
+ * head/tail indices are free running 8 bit counters
+*/
+#define TWI_QUEUE_SIZE				(8U)
+#define TWI_QUEUE_MASK				(TWI_QUEUE_SIZE - 1U)
+
+#if ( (TWI_QUEUE_SIZE & TWI_QUEUE_MASK) != 0U ) || (TWI_QUEUE_SIZE > 128U)
+#error "TWI_QUEUE_SIZE must be a power of 2 and not bigger than 128"
+#endif
+
 /* I2C Status Bits in the TWSR Register */
 #define TW_START         0x08 // start has been sent
 #define TW_REP_START     0x10 // repeated start
@@ -45,6 +109,28 @@
 #define TW_MT_DATA_ACK   0x28 // Master transmit data and ACK has been received from Slave.
 #define TW_MR_DATA_ACK   0x50 // Master received data and send ACK to slave
 #define TW_MR_DATA_NACK  0x58 // Master received data but doesn't send ACK to slave
+#define TW_MT_SLA_W_NACK 0x20 // Master transmit ( slave address + Write request ) to slave + NACK received from slave
+#define TW_MT_DATA_NACK  0x30 // Master transmit data and NACK has been received from Slave.
+#define TW_ARB_LOST      0x38 // Arbitration lost in slave address or data bytes
+#define TW_MT_SLA_R_NACK 0x48 // Master transmit ( slave address + Read request ) to slave + NACK received from slave
+#define TW_NO_INFO       0xF8 // No relevant state information available (TWINT = 0)
+#define TW_BUS_ERROR     0x00 // Bus error due to an illegal START or STOP condition
+
+/* I2C Status Bits in the TWSR Register in slave mode */
+#define TW_SR_SLA_ACK             0x60 // Own address + Write request received and ACK sent
+#define TW_SR_ARB_LOST_SLA_ACK    0x68 // Arbitration lost as master, own address + Write request received and ACK sent
+#define TW_SR_GCALL_ACK           0x70 // General call address received and ACK sent
+#define TW_SR_ARB_LOST_GCALL_ACK  0x78 // Arbitration lost as master, general call address received and ACK sent
+#define TW_SR_DATA_ACK            0x80 // Data received after own address and ACK sent
+#define TW_SR_DATA_NACK           0x88 // Data received after own address and NACK sent
+#define TW_SR_GCALL_DATA_ACK      0x90 // Data received after general call and ACK sent
+#define TW_SR_GCALL_DATA_NACK     0x98 // Data received after general call and NACK sent
+#define TW_SR_STOP                0xA0 // STOP or REPEATED START received while addressed as slave
+#define TW_ST_SLA_ACK             0xA8 // Own address + Read request received and ACK sent
+#define TW_ST_ARB_LOST_SLA_ACK    0xB0 // Arbitration lost as master, own address + Read request received and ACK sent
+#define TW_ST_DATA_ACK            0xB8 // Data transmitted to master and ACK received
+#define TW_ST_DATA_NACK           0xC0 // Data transmitted to master and NACK received (Master needs no more)
+#define TW_ST_LAST_DATA           0xC8 // Last data transmitted (TWEA = 0) and ACK received
 
 /************************************************************************************************/
 
@@ -68,6 +154,55 @@ typedef enum{
 
 }TWI_BitRateType;
 
+/********************************************************************************
+
+ [Enumuration Name]:		TWI_StatusType
+
+ [Enumuration Description]: Result of a TWI step or transaction
+
+*********************************************************************************/
+typedef enum{
+
+	TWI_OK,
+	TWI_BUSY,
+	TWI_ADDRESS_NACK,
+	TWI_DATA_NACK,
+	TWI_ARBITRATION_LOST,
+	TWI_BUS_ERROR,
+	TWI_TIMEOUT
+
+}TWI_StatusType;
+
+
+/********************************************************************************
+
+ [Structure Name]:			TWI_TransactionType
+
+ [Structure Description]:	Structure which describes a whole master transaction
+ 	 	 	 	 	 	 	run from TWI ISR:
+ 	 	 	 	 	 	 	START, SLA+W, Tx bytes, REPEATED START, SLA+R, Rx bytes, STOP
+ 	 	 	 	 	 	 	- Write part is skipped if TxLength is 0
+ 	 	 	 	 	 	 	- Read part is skipped if RxLength is 0
+ 	 	 	 	 	 	 	- Structure and buffers MUST stay valid till the callback
+
+*********************************************************************************/
+typedef struct{
+
+	uint8			SlaveAddress;		/* 7 bits address of the slave (Without R/W bit)						*/
+
+	const uint8		*TxBuffer;			/* Bytes written to the slave											*/
+
+	uint8			TxLength;			/* Number of bytes written to the slave									*/
+
+	uint8			*RxBuffer;			/* Array to save the bytes read from the slave							*/
+
+	uint8			RxLength;			/* Number of bytes read from the slave (Last one is NACKed)				*/
+
+	void			(*CallBack)(TWI_StatusType status);	/* Called from TWI ISR when the transaction ends
+														   (NULL_PTR if not needed)								*/
+}TWI_TransactionType;
+
+
 /********************************************************************************
 
  [Structure Name]:			TWI_ConfigType
@@ -79,16 +214,22 @@ typedef enum{
 
 typedef struct{
 
-	uint8 			Address;			/* You can find this value @ADDRESS_OF_MC_IN_SLAVE_MODE
+	uint8			Address;			/* You can find this value @ADDRESS_OF_MC_IN_SLAVE_MODE
 										   if you are using this MC in slave mode and there is
 										   NO OTHER DEVICES HAVE THE SAME ADDRESS
 										   used to decide Address of device if it's a slave */
 
-	TWI_BitRateType BitRate;			/* You can find this value @TWI_BitRateType
-										   Value of bit rate required for I2C from programmer */
+	uint32			BitRate;			/* You can find this value @TWI_BitRateType
+										   Value of bit rate required for I2C from programmer
+										   (Fastest rate not above it is used, limited by TWI_MAX_BIT_RATE) */
 
 	uint8			InterruptMode;		/* You can find this value @INTERRUPT_MODE
-	 	 	 	 	 	 	   	   	   	   Used to decied which operating mode is activated (Polling or Interrupt) */
+	 	 	 	 	 	 	   	   	   	   Used to decied which operating mode is activated (Polling or Interrupt)
+	 	 	 	 	 	 	   	   	   	   (TWI_startTransaction enables the interrupt by itself) */
+
+	uint8			SlaveMode;			/* You can find this value @SLAVE_MODE
+										   Used to answer masters calling Address from TWI ISR
+										   (Register map served by the slave callbacks) */
 }TWI_ConfigType;
 
 
@@ -101,7 +242,10 @@ typedef struct{
  [Function Name]:	TWI_init
 
  [Description]:		Used to initialize I2C Module
- 	 	 	 	 	- 1 pre-scaler to ease bit rate calculations
+ 	 	 	 	 	- TWBR and TWPS are chosen together to get the fastest bit rate
+ 	 	 	 	 	  not above the required one (TWBR >= TWI_TWBR_MIN)
+ 	 	 	 	 	- Polling and transaction step timeouts are made twice
+ 	 	 	 	 	  the byte time of a slow bit rate
  	 	 	 	 	- Initiate with device address (If not a microcontroller or master)
  	 	 	 	 	  if master, its address will be 0x01
  	 	 	 	 	- Enable I2C Module
@@ -124,6 +268,7 @@ void TWI_init(const TWI_ConfigType* config_Ptr);
  [Function Name]:	TWI_start
 
  [Description]:		Used to send start bit on I2C Frame
+ 	 	 	 	 	(Waits at most one step timeout for the bus)
 
  [Args]:			None
 
@@ -133,9 +278,9 @@ void TWI_init(const TWI_ConfigType* config_Ptr);
 
  [in/out]			None
 
- [Returns]:			None
+ [Returns]:			TWI_OK if the start bit is sent, TWI_TIMEOUT otherwise
 **********************************************************************************/
-void TWI_start(void);
+TWI_StatusType TWI_start(void);
 
 
 /********************************************************************************
@@ -160,6 +305,7 @@ void TWI_stop(void);
  [Function Name]:	TWI_write
 
  [Description]:		Used to write data/address on I2C Frame
+ 	 	 	 	 	(Waits at most one step timeout for the byte)
 
  [Args]:			data
 
@@ -167,17 +313,19 @@ void TWI_stop(void);
 
  [out]				None
 
- [in/out]]			None
+ [in/out]			None
 
- [Returns]:]		None
+ [Returns]:			TWI_OK if the byte is sent, TWI_TIMEOUT otherwise
 **********************************************************************************/
-void TWI_write(uint8 data);
+TWI_StatusType TWI_write(uint8 data);
 
 
 /********************************************************************************
  [Function Name]:	TWI_readWithACK
 
  [Description]:		Perform a read operation with sending ACK
+ 	 	 	 	 	(Waits at most one step timeout, TWI_getStatus gives
+ 	 	 	 	 	TW_NO_INFO if no byte is received)
 
  [Args]:			None
 
@@ -196,6 +344,8 @@ uint8 TWI_readWithACK(void);
  [Function Name]:	TWI_readWithNACK
 
  [Description]:		Perform a read operation without sending ACK
+ 	 	 	 	 	(Waits at most one step timeout, TWI_getStatus gives
+ 	 	 	 	 	TW_NO_INFO if no byte is received)
 
  [Args]:			None
 
@@ -247,4 +397,254 @@ uint8 TWI_getStatus(void);
 **********************************************************************************/
 void TWI_setCallBack(void (*f_ptr)(void));
 
+
+/********************************************************************************
+ [Function Name]:	TWI_setSlaveWriteCallBack
+
+ [Description]:		Function Callback called from TWI ISR in slave mode for every
+ 	 	 	 	 	byte written by the master to the register map
+ 	 	 	 	 	- First byte after the address selects the register
+ 	 	 	 	 	- Next bytes are written to this register and the following ones
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to function which takes the register and the byte
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void TWI_setSlaveWriteCallBack(void (*f_ptr)(uint8 reg, uint8 data));
+
+
+/********************************************************************************
+ [Function Name]:	TWI_setSlaveReadCallBack
+
+ [Description]:		Function Callback called from TWI ISR in slave mode for every
+ 	 	 	 	 	byte read by the master from the register map
+ 	 	 	 	 	- Reading starts from the last selected register and
+ 	 	 	 	 	  goes to the following ones
+ 	 	 	 	 	- 0xFF is sent if no callback is set
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to function which returns the byte of a register
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void TWI_setSlaveReadCallBack(uint8 (*f_ptr)(uint8 reg));
+
+
+/********************************************************************************
+ [Function Name]:	TWI_startTransaction
+
+ [Description]:		Used to start a whole master transaction which continues
+ 	 	 	 	 	in TWI ISR without any busy wait, the callback of the
+ 	 	 	 	 	transaction is called after the STOP bit
+ 	 	 	 	 	(Global Interrupts must be enabled)
+
+ [Args]:			transaction_Ptr
+
+ [in]				transaction_Ptr: Pointer to the transaction structure
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			TWI_OK if the transaction started, TWI_BUSY if a previous
+ 	 	 	 	 	transaction is still running (Or the bus recovery after
+ 	 	 	 	 	a timeout waits for a call from outside ISRs)
+**********************************************************************************/
+TWI_StatusType TWI_startTransaction(const TWI_TransactionType* transaction_Ptr);
+
+
+/********************************************************************************
+ [Function Name]:	TWI_submitTransaction
+
+ [Description]:		Used to add a master transaction to the transaction queue
+ 	 	 	 	 	- Starts at once if the bus is free
+ 	 	 	 	 	- Otherwise it starts from TWI ISR right after the running one
+ 	 	 	 	 	  with STOP then START (No idle bus time, STOP lets a 24Cxx
+ 	 	 	 	 	  commit the bytes written by the running one)
+ 	 	 	 	 	- Transactions run in the order they are submitted
+ 	 	 	 	 	- Bus recovery after a timeout is done here if it is called
+ 	 	 	 	 	  outside ISRs (From ISRs the transaction is queued behind it)
+ 	 	 	 	 	(Global Interrupts must be enabled)
+
+ [Args]:			transaction_Ptr
+
+ [in]				transaction_Ptr: Pointer to the transaction structure
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			TWI_OK if the transaction is started or queued,
+ 	 	 	 	 	TWI_BUSY if the queue is full
+**********************************************************************************/
+TWI_StatusType TWI_submitTransaction(const TWI_TransactionType* transaction_Ptr);
+
+
+/********************************************************************************
+ [Function Name]:	TWI_isBusy
+
+ [Description]:		Used to know if a transaction is running on the bus
+ 	 	 	 	 	(Or waiting in the transaction queue, or for the bus
+ 	 	 	 	 	recovery after a timeout)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			TRUE if a transaction is running, FALSE otherwise
+**********************************************************************************/
+uint8 TWI_isBusy(void);
+
+
+/********************************************************************************
+ [Function Name]:	TWI_recoverPending
+
+ [Description]:		Used to recover the bus after a transaction timeout, then
+ 	 	 	 	 	start the transactions queued behind it (Nothing to do if
+ 	 	 	 	 	no recovery is pending)
+ 	 	 	 	 	- TWI_transfer, TWI_startTransaction and TWI_submitTransaction
+ 	 	 	 	 	  call it already when they are called outside ISRs
+ 	 	 	 	 	(MUST NOT be called from ISRs, TWI_busRecovery busy waits)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void TWI_recoverPending(void);
+
+
+/********************************************************************************
+ [Function Name]:	TWI_isRecoveryPending
+
+ [Description]:		Used to know if the bus recovery after a transaction timeout
+ 	 	 	 	 	waits for a TWI call from outside ISRs (Queued transactions
+ 	 	 	 	 	do not start till then)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			TRUE if the bus recovery is pending, FALSE otherwise
+**********************************************************************************/
+uint8 TWI_isRecoveryPending(void);
+
+
+/********************************************************************************
+ [Function Name]:	TWI_cancelTransaction
+
+ [Description]:		Used to remove a transaction from the transaction queue
+ 	 	 	 	 	before it starts (Its callback is NOT called), so its
+ 	 	 	 	 	buffers and structure can be used again
+
+ [Args]:			transaction_Ptr
+
+ [in]				transaction_Ptr: Pointer to the queued transaction structure
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			TWI_OK if the transaction was removed, TWI_BUSY if it is
+ 	 	 	 	 	running (Or not queued)
+**********************************************************************************/
+TWI_StatusType TWI_cancelTransaction(const TWI_TransactionType* transaction_Ptr);
+
+
+/********************************************************************************
+ [Function Name]:	TWI_timeoutTick
+
+ [Description]:		Time base of TWI transaction timeouts, it should be given as
+ 	 	 	 	 	a callback to a timer which interrupts every TWI_TIMEOUT_TICK_MS
+ 	 	 	 	 	- A stuck transaction ends with TWI_TIMEOUT, no busy wait here
+ 	 	 	 	 	- Bus is recovered later by the next TWI_transfer, or
+ 	 	 	 	 	  TWI_startTransaction/TWI_submitTransaction called outside
+ 	 	 	 	 	  ISRs, then the queued transactions start
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void TWI_timeoutTick(void);
+
+
+/********************************************************************************
+ [Function Name]:	TWI_busRecovery
+
+ [Description]:		Used to free the bus if a slave holds SDA low
+ 	 	 	 	 	(Reset in the middle of a read for example)
+ 	 	 	 	 	- TWI is disabled and SCL is clocked by hand up to 9 times
+ 	 	 	 	 	  till the slave releases SDA
+ 	 	 	 	 	- STOP condition is sent by hand then TWI is enabled again
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			TWI_OK if the bus is free, TWI_BUS_ERROR if SDA is still low
+**********************************************************************************/
+TWI_StatusType TWI_busRecovery(void);
+
+
+/********************************************************************************
+ [Function Name]:	TWI_transfer
+
+ [Description]:		Used to run a whole master transaction with busy wait:
+ 	 	 	 	 	START, SLA+W, Tx bytes, REPEATED START, SLA+R, Rx bytes, STOP
+ 	 	 	 	 	- Write part is skipped if txLength is 0
+ 	 	 	 	 	- Read part is skipped if rxLength is 0
+ 	 	 	 	 	- Every Rx byte is ACKed except the last one
+ 	 	 	 	 	- Frame is ended with STOP on any error (Stuck bus is recovered)
+ 	 	 	 	 	- Recovers the bus after a transaction timeout, then waits
+ 	 	 	 	 	  for the queued transactions to end first
+
+ [Args]:			address, txBuffer, txLength, rxBuffer, rxLength
+
+ [in]				address:  7 bits address of the slave (Without R/W bit)
+ 	 	 	 	 	txBuffer: Bytes written to the slave
+ 	 	 	 	 	txLength: Number of bytes written to the slave
+ 	 	 	 	 	rxLength: Number of bytes read from the slave
+
+ [out]				rxBuffer: Array to save the bytes read from the slave
+
+ [in/out]			None
+
+ [Returns]:			TWI_OK if everything is fine, otherwise the reason of the failure
+**********************************************************************************/
+TWI_StatusType TWI_transfer(uint8 address, const uint8 *txBuffer, uint8 txLength, uint8 *rxBuffer, uint8 rxLength);
+
 #endif /* I2C_H_ */
@@ -0,0 +1,435 @@
+ /******************************************************************************
+ *
+ * Module: Internal EEPROM
+ *
+ * File Name: internal_eeprom.c
+ *
+ * Description: Source file for the On-chip EEPROM of the MCU behind the EEPROM
+ * 				functions of external_eeprom.h (EEAR, EEDR and EECR registers)
+ * 				- Built only with -DEEPROM_BACKEND=EEPROM_BACKEND_INTERNAL
+ * 				- No I2C traffic, a read takes 4 clock cycles
+ * 				- Background writes are served by EE_RDY interrupt, one byte
+ * 				  every write cycle
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#include "micro_config.h"
+#include "common_macros.h"
+#include "external_eeprom.h"
+
+#if (EEPROM_BACKEND == EEPROM_BACKEND_INTERNAL)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* TRUE from EEPROM_writeBlockAsync till the write cycle of its last byte ends */
+static volatile uint8 g_asyncBusy = FALSE;
+
+/* Bytes of the background write which are not written yet */
+static uint16 g_asyncAddress;
+static const uint8 *g_asyncData;
+static uint16 g_asyncLength;
+
+/* Pointer to the function called with the result of the background write */
+static void (*volatile g_asyncCallBackPtr)(EEPROM_StatusType status) = NULL_PTR;
+
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Wait for the write cycle of the last byte (EEWE is cleared by HW when it ends) */
+static void EEPROM_waitReady(void){
+
+	while(BIT_IS_SET(EECR,EEWE)){}
+}
+
+
+/* Read one byte, write cycle MUST be ended (CPU is halted 4 cycles) */
+static uint8 EEPROM_read(uint16 u16addr){
+
+	EEAR = u16addr;
+	SET_BIT(EECR,EERE);
+
+	return EEDR;
+}
+
+
+/*
+ * Start the write cycle of one byte, write cycle of the last byte MUST be ended
+ * Byte which has the same value is NOT written again (No write cycle and no wear)
+*/
+static void EEPROM_program(uint16 u16addr, uint8 u8data){
+
+	uint8 sreg;
+
+	if(EEPROM_read(u16addr) == u8data){
+
+		return;
+	}
+
+	EEDR = u8data;
+
+	sreg = SREG;
+
+	cli();
+
+	/* EEWE MUST be set within 4 clock cycles after EEMWE, so SBI instructions are used */
+	__asm__ __volatile__(
+		"sbi %0, %1"	"\n\t"
+		"sbi %0, %2"	"\n\t"
+		:
+		: "I" (_SFR_IO_ADDR(EECR)), "I" (EEMWE), "I" (EEWE)
+	);
+
+	SREG = sreg;
+}
+
+
+/* Background write owns the EEPROM till it ends (Its callback comes from an ISR) */
+static void EEPROM_waitAsync(void){
+
+	while(g_asyncBusy == TRUE){}
+}
+
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+/* Write cycle ended (It keeps coming while EERIE is set and no write is running) */
+ISR(EE_RDY_vect){
+
+	if(g_asyncLength == 0){
+
+		/* Last byte is written */
+		CLEAR_BIT(EECR,EERIE);
+
+		g_asyncBusy = FALSE;
+
+		if(g_asyncCallBackPtr != NULL_PTR){
+
+			(*g_asyncCallBackPtr)(EEPROM_OK);
+		}
+
+		return;
+	}
+
+	EEPROM_program(g_asyncAddress, *g_asyncData);
+
+	g_asyncAddress++;
+	g_asyncData++;
+	g_asyncLength--;
+}
+
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	EEPROM_init
+
+ [Description]:		Used to initialize the On-chip EEPROM (Waits for a write
+ 	 	 	 	 	cycle which may be running from before a reset)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void EEPROM_init(void)
+{
+	CLEAR_BIT(EECR,EERIE);
+
+	EEPROM_waitReady();
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_writeByte
+
+ [Description]:		Function used to write byte on EEPROM
+ 	 	 	 	 	(Next access waits for the write cycle)
+
+ [Args]:			u16addr, u8data
+
+ [in]				u16addr: Address of segment needed to be written on it
+ 	 	 	 	 	u8data:	 Byte required to be written
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Status of writing (EEPROM_OK, or EEPROM_NACK if the address
+ 	 	 	 	 	is out of the EEPROM)
+**********************************************************************************/
+EEPROM_StatusType EEPROM_writeByte(uint16 u16addr, uint8 u8data){
+
+	if(u16addr >= EEPROM_SIZE){
+
+		return EEPROM_NACK;
+	}
+
+	EEPROM_waitAsync();
+	EEPROM_waitReady();
+
+	EEPROM_program(u16addr, u8data);
+
+	return EEPROM_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_readByte
+
+ [Description]:		Function used to read byte on EEPROM
+
+ [Args]:			u16addr, u8data
+
+ [in]				u16addr: Address of segment needed to be written on it
+
+ [out]				u8data:	 Pointer to an empty char to save the read byte on it
+
+ [in/out]			None
+
+ [Returns]:			Status of Reading (EEPROM_OK, or EEPROM_NACK if the address
+ 	 	 	 	 	is out of the EEPROM)
+**********************************************************************************/
+EEPROM_StatusType EEPROM_readByte(uint16 u16addr, uint8 *u8data)
+{
+	return EEPROM_readBlock(u16addr, u8data, 1U);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_writePage
+
+ [Description]:		Function used to write bytes of one EEPROM_PAGE_SIZE block
+ 	 	 	 	 	on EEPROM, one write cycle every changed byte
+ 	 	 	 	 	(Next access waits for the last write cycle)
+
+ [Args]:			u16addr, data, length
+
+ [in]				u16addr: Address of the first byte
+ 	 	 	 	 	data:	 Bytes required to be written
+ 	 	 	 	 	length:	 Number of bytes (They MUST NOT cross the block end)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Status of writing (EEPROM_OK if everything is fine)
+**********************************************************************************/
+EEPROM_StatusType EEPROM_writePage(uint16 u16addr, const uint8 *data, uint8 length){
+
+	/* Same limit as the external EEPROM page, so both backends accept the same writes */
+	if( ( (u16addr % EEPROM_PAGE_SIZE) + length ) > EEPROM_PAGE_SIZE ){
+
+		return EEPROM_PAGE_OVERFLOW;
+	}
+
+	return EEPROM_writeBlock(u16addr, data, length);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_writeBlock
+
+ [Description]:		Function used to write any number of bytes on EEPROM,
+ 	 	 	 	 	one write cycle every changed byte
+ 	 	 	 	 	(Next access waits for the last write cycle)
+
+ [Args]:			u16addr, data, length
+
+ [in]				u16addr: Address of the first byte
+ 	 	 	 	 	data:	 Bytes required to be written
+ 	 	 	 	 	length:	 Number of bytes
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Status of writing (EEPROM_OK, or EEPROM_NACK if the bytes
+ 	 	 	 	 	are out of the EEPROM)
+**********************************************************************************/
+EEPROM_StatusType EEPROM_writeBlock(uint16 u16addr, const uint8 *data, uint16 length){
+
+	if( ((uint32)u16addr + length) > EEPROM_SIZE ){
+
+		return EEPROM_NACK;
+	}
+
+	EEPROM_waitAsync();
+
+	while(length > 0){
+
+		EEPROM_waitReady();
+		EEPROM_program(u16addr, *data);
+
+		u16addr++;
+		data++;
+		length--;
+	}
+
+	return EEPROM_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_readBlock
+
+ [Description]:		Function used to read number of bytes from EEPROM
+
+ [Args]:			u16addr, data, length
+
+ [in]				u16addr: Address of the first byte
+ 	 	 	 	 	length:	 Number of bytes
+
+ [out]				data:	 Array to save the read bytes on it
+
+ [in/out]			None
+
+ [Returns]:			Status of Reading (EEPROM_OK, or EEPROM_NACK if the bytes
+ 	 	 	 	 	are out of the EEPROM)
+**********************************************************************************/
+EEPROM_StatusType EEPROM_readBlock(uint16 u16addr, uint8 *data, uint16 length){
+
+	if( ((uint32)u16addr + length) > EEPROM_SIZE ){
+
+		return EEPROM_NACK;
+	}
+
+	/* Reads wait only if a write cycle is still running */
+	EEPROM_waitAsync();
+	EEPROM_waitReady();
+
+	while(length > 0){
+
+		*data = EEPROM_read(u16addr);
+
+		u16addr++;
+		data++;
+		length--;
+	}
+
+	return EEPROM_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_writeBlockAsync
+
+ [Description]:		Function used to write any number of bytes on EEPROM in the
+ 	 	 	 	 	background without any busy wait
+ 	 	 	 	 	- Every byte is written from EE_RDY ISR when the write cycle
+ 	 	 	 	 	  of the byte before it ends
+ 	 	 	 	 	- Callback is called from the ISR when the last write cycle ends
+ 	 	 	 	 	  (At once if length is 0)
+ 	 	 	 	 	- Other EEPROM functions wait for the background write to end
+ 	 	 	 	 	  (Global Interrupts must be enabled, and they must NOT be
+ 	 	 	 	 	  called from ISRs while it is running)
+
+ [Args]:			u16addr, data, length, f_ptr
+
+ [in]				u16addr: Address of the first byte
+ 	 	 	 	 	data:	 Bytes required to be written (MUST stay valid till the callback)
+ 	 	 	 	 	length:	 Number of bytes
+ 	 	 	 	 	f_ptr:	 Pointer to the function called with the result
+ 	 	 	 	 	 	 	 (NULL_PTR if not needed)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			EEPROM_OK if the write started (Result comes to the callback),
+ 	 	 	 	 	EEPROM_BUSY if another background write is running,
+ 	 	 	 	 	EEPROM_NACK if the bytes are out of the EEPROM
+**********************************************************************************/
+EEPROM_StatusType EEPROM_writeBlockAsync(uint16 u16addr, const uint8 *data, uint16 length, void (*f_ptr)(EEPROM_StatusType status)){
+
+	uint8 sreg = SREG;
+
+	if( ((uint32)u16addr + length) > EEPROM_SIZE ){
+
+		return EEPROM_NACK;
+	}
+
+	cli();
+
+	if(g_asyncBusy == TRUE){
+
+		SREG = sreg;
+		return EEPROM_BUSY;
+	}
+
+	g_asyncCallBackPtr	= f_ptr;
+	g_asyncAddress		= u16addr;
+	g_asyncData			= data;
+	g_asyncLength		= length;
+
+	if(length == 0){
+
+		/* Nothing to write, callback is called at once */
+		SREG = sreg;
+
+		if(f_ptr != NULL_PTR){
+
+			(*f_ptr)(EEPROM_OK);
+		}
+
+		return EEPROM_OK;
+	}
+
+	g_asyncBusy = TRUE;
+
+	/* EE_RDY interrupt comes as soon as no write cycle is running */
+	SET_BIT(EECR,EERIE);
+
+	SREG = sreg;
+
+	return EEPROM_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_writeCycleTick
+
+ [Description]:		Time base of background writes of the External EEPROM
+ 	 	 	 	 	Nothing to poll here, On-chip EEPROM write cycles end with
+ 	 	 	 	 	EE_RDY interrupt (Kept so the timer callback is the same for
+ 	 	 	 	 	both backends)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void EEPROM_writeCycleTick(void){
+
+}
+
+#endif /* EEPROM_BACKEND */
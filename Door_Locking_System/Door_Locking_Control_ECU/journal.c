@@ -0,0 +1,356 @@
+ /******************************************************************************
+ *
+ * Module: Journal
+ *
+ * File Name: journal.c
+ *
+ * Description: Source file for the wear levelled record journal on External EEPROM
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#include "journal.h"
+#include "crc.h"
+
+/* Index of the CRC-8 byte in a record (After the sequence and the payload) */
+#define JOURNAL_CRC_INDEX		(2U + JOURNAL_PAYLOAD_SIZE)
+
+/* CRC-8 start value of a record (NOT 0x00, so an all zeros slot is not a valid record) */
+#define JOURNAL_CRC_SEED		(0xA5U)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* TRUE after the journal region is scanned successfully */
+static uint8 g_journalScanned = FALSE;
+
+/* TRUE if the journal has no valid record */
+static uint8 g_journalEmpty = TRUE;
+
+/* Slot and sequence number of the newest valid record */
+static uint8 g_newestSlot = 0;
+static uint16 g_newestSequence = 0;
+
+/* TRUE from Journal_appendAsync till its record is written */
+static volatile uint8 g_appendPending = FALSE;
+
+/* Record of the background append, its slot and sequence number */
+static uint8 g_appendRecord[JOURNAL_RECORD_SIZE];
+static uint8 g_appendSlot;
+static uint16 g_appendSequence;
+
+/* Pointer to the function called with the result of the background append */
+static void (*volatile g_appendCallBackPtr)(Journal_StatusType status) = NULL_PTR;
+
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* EEPROM address of a journal slot */
+static uint16 Journal_slotAddress(uint8 slot){
+
+	return (uint16)( JOURNAL_START_ADDRESS + ( (uint16)slot * JOURNAL_RECORD_SIZE ) );
+}
+
+
+/* Check the CRC of a record and get its sequence number (Erased slots are not valid) */
+static uint8 Journal_recordValid(const uint8 *record, uint16 *sequence){
+
+	*sequence = (uint16)( record[0] | ( (uint16)record[1] << 8 ) );
+
+	if(*sequence == JOURNAL_ERASED_SEQUENCE){
+
+		return FALSE;
+	}
+
+	return ( (CRC8_calculate(JOURNAL_CRC_SEED, record, JOURNAL_CRC_INDEX) == record[JOURNAL_CRC_INDEX]) ? TRUE : FALSE );
+}
+
+
+/* Build the record of a payload for the slot after the newest record */
+static Journal_StatusType Journal_buildRecord(const uint8 *payload, uint8 *record, uint8 *slot, uint16 *sequence){
+
+	uint8 i;
+
+	/* Slot after the newest record is NOT known if the scan failed, so scan again */
+	if( (g_journalScanned == FALSE) && (Journal_init() == JOURNAL_ERROR) ){
+
+		return JOURNAL_ERROR;
+	}
+
+	*slot		= 0;
+	*sequence	= 0;
+
+	if(g_journalEmpty == FALSE){
+
+		*slot		= (uint8)( (g_newestSlot + 1U) % JOURNAL_RECORD_COUNT );
+		*sequence	= (uint16)(g_newestSequence + 1U);
+
+		/* Erased value is never used as a sequence number */
+		if(*sequence == JOURNAL_ERASED_SEQUENCE){
+
+			*sequence = 0;
+		}
+	}
+
+	record[0] = (uint8)(*sequence);
+	record[1] = (uint8)(*sequence >> 8);
+
+	for(i = 0; i < JOURNAL_PAYLOAD_SIZE; i++){
+
+		record[2U + i] = payload[i];
+	}
+
+	record[JOURNAL_CRC_INDEX] = CRC8_calculate(JOURNAL_CRC_SEED, record, JOURNAL_CRC_INDEX);
+
+	/* Unused bytes stay erased */
+	for(i = JOURNAL_CRC_INDEX + 1U; i < JOURNAL_RECORD_SIZE; i++){
+
+		record[i] = 0xFF;
+	}
+
+	return JOURNAL_OK;
+}
+
+
+/* Background append ended (Called from an ISR) */
+static void Journal_appendDone(EEPROM_StatusType status){
+
+	if(status == EEPROM_OK){
+
+		g_journalEmpty		= FALSE;
+		g_newestSlot		= g_appendSlot;
+		g_newestSequence	= g_appendSequence;
+	}
+
+	g_appendPending = FALSE;
+
+	if(g_appendCallBackPtr != NULL_PTR){
+
+		(*g_appendCallBackPtr)( (status == EEPROM_OK) ? JOURNAL_OK : JOURNAL_ERROR );
+	}
+}
+
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	Journal_init
+
+ [Description]:		Used to find the newest valid record by scanning the journal
+ 	 	 	 	 	region one page at a time (EEPROM_init must be called first)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			JOURNAL_OK if a record is found, JOURNAL_EMPTY if there is no
+ 	 	 	 	 	valid record, JOURNAL_ERROR if EEPROM can NOT be read
+**********************************************************************************/
+Journal_StatusType Journal_init(void){
+
+	/* One page of records */
+	uint8 page[EEPROM_PAGE_SIZE];
+
+	/* Slot of the first record in the page */
+	uint8 slot = 0;
+
+	/* Index of a record in the page */
+	uint8 i;
+
+	uint16 sequence;
+
+	g_journalScanned	= FALSE;
+	g_journalEmpty		= TRUE;
+
+	while(slot < JOURNAL_RECORD_COUNT){
+
+		/* One sequential read for every page */
+		if(EEPROM_readBlock(Journal_slotAddress(slot), page, EEPROM_PAGE_SIZE) != EEPROM_OK){
+
+			return JOURNAL_ERROR;
+		}
+
+		for(i = 0; i < EEPROM_PAGE_SIZE; i += JOURNAL_RECORD_SIZE){
+
+			/* Sequence numbers wrap, so the newer one is the one after the other in 16 bit arithmetic */
+			if( Journal_recordValid(&page[i], &sequence) &&
+				( (g_journalEmpty == TRUE) || ( (sint16)(sequence - g_newestSequence) > 0 ) ) ){
+
+				g_journalEmpty		= FALSE;
+				g_newestSlot		= slot;
+				g_newestSequence	= sequence;
+			}
+
+			slot++;
+		}
+	}
+
+	g_journalScanned = TRUE;
+
+	return ( (g_journalEmpty == TRUE) ? JOURNAL_EMPTY : JOURNAL_OK );
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Journal_read
+
+ [Description]:		Used to read the payload of the newest valid record
+
+ [Args]:			payload
+
+ [in]				None
+
+ [out]				payload: Array of JOURNAL_PAYLOAD_SIZE bytes to save the payload on it
+
+ [in/out]			None
+
+ [Returns]:			JOURNAL_OK if the payload is read, JOURNAL_EMPTY if there is
+ 	 	 	 	 	no valid record, JOURNAL_ERROR otherwise
+**********************************************************************************/
+Journal_StatusType Journal_read(uint8 *payload){
+
+	uint8 record[JOURNAL_RECORD_SIZE];
+
+	uint16 sequence;
+
+	uint8 i;
+
+	/* Background append decides the newest record first */
+	while(g_appendPending == TRUE){}
+
+	/* Newest record is NOT known if the scan failed, so scan again (Empty is not assumed) */
+	if( (g_journalScanned == FALSE) && (Journal_init() == JOURNAL_ERROR) ){
+
+		return JOURNAL_ERROR;
+	}
+
+	if(g_journalEmpty == TRUE){
+
+		return JOURNAL_EMPTY;
+	}
+
+	if( (EEPROM_readBlock(Journal_slotAddress(g_newestSlot), record, JOURNAL_RECORD_SIZE) != EEPROM_OK) ||
+		(Journal_recordValid(record, &sequence) == FALSE) || (sequence != g_newestSequence) ){
+
+		return JOURNAL_ERROR;
+	}
+
+	for(i = 0; i < JOURNAL_PAYLOAD_SIZE; i++){
+
+		payload[i] = record[2U + i];
+	}
+
+	return JOURNAL_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Journal_append
+
+ [Description]:		Used to save a new payload in the slot after the newest record
+ 	 	 	 	 	with the next sequence number (One page write)
+ 	 	 	 	 	- Older records stay valid till their slot is used again
+ 	 	 	 	 	- If the write fails, the previous record is still the newest
+
+ [Args]:			payload
+
+ [in]				payload: Array of JOURNAL_PAYLOAD_SIZE bytes to be saved
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			JOURNAL_OK if the record is written, JOURNAL_ERROR otherwise
+**********************************************************************************/
+Journal_StatusType Journal_append(const uint8 *payload){
+
+	uint8 record[JOURNAL_RECORD_SIZE];
+
+	uint8 slot;
+	uint16 sequence;
+
+	/* Background append decides the newest record first */
+	while(g_appendPending == TRUE){}
+
+	if(Journal_buildRecord(payload, record, &slot, &sequence) != JOURNAL_OK){
+
+		return JOURNAL_ERROR;
+	}
+
+	if(EEPROM_writePage(Journal_slotAddress(slot), record, JOURNAL_RECORD_SIZE) != EEPROM_OK){
+
+		return JOURNAL_ERROR;
+	}
+
+	g_journalEmpty		= FALSE;
+	g_newestSlot		= slot;
+	g_newestSequence	= sequence;
+
+	return JOURNAL_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Journal_appendAsync
+
+ [Description]:		Used to save a new payload like Journal_append, but the page
+ 	 	 	 	 	write and its write cycle run in the background
+ 	 	 	 	 	(EEPROM_writeBlockAsync), the record is the newest one only
+ 	 	 	 	 	after its write cycle ends
+ 	 	 	 	 	- Callback is called from an ISR with the result
+ 	 	 	 	 	- Journal_read and Journal_append wait for it to end
+
+ [Args]:			payload, f_ptr
+
+ [in]				payload: Array of JOURNAL_PAYLOAD_SIZE bytes to be saved
+ 	 	 	 	 	 	 	 (Copied, it can change after the return)
+ 	 	 	 	 	f_ptr:	 Pointer to the function called with the result
+ 	 	 	 	 	 	 	 (JOURNAL_OK or JOURNAL_ERROR)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			JOURNAL_OK if the write started, JOURNAL_BUSY if a background
+ 	 	 	 	 	append is running, JOURNAL_ERROR otherwise
+**********************************************************************************/
+Journal_StatusType Journal_appendAsync(const uint8 *payload, void (*f_ptr)(Journal_StatusType status)){
+
+	if(g_appendPending == TRUE){
+
+		return JOURNAL_BUSY;
+	}
+
+	if(Journal_buildRecord(payload, g_appendRecord, &g_appendSlot, &g_appendSequence) != JOURNAL_OK){
+
+		return JOURNAL_ERROR;
+	}
+
+	g_appendCallBackPtr	= f_ptr;
+	g_appendPending		= TRUE;
+
+	if(EEPROM_writeBlockAsync(Journal_slotAddress(g_appendSlot), g_appendRecord, JOURNAL_RECORD_SIZE, Journal_appendDone) != EEPROM_OK){
+
+		g_appendPending = FALSE;
+
+		return JOURNAL_ERROR;
+	}
+
+	return JOURNAL_OK;
+}
@@ -0,0 +1,188 @@
+ /******************************************************************************
+ *
+ * Module: Journal
+ *
+ * File Name: journal.h
+ *
+ * Description: Header file for the wear levelled record journal on External EEPROM
+ * 				- Every update is appended to the next slot of a ring of records
+ * 				  (One page write, cells of the region wear equally)
+ * 				- Every record has a sequence number and CRC-8, so a record
+ * 				  broken by a reset in the middle of its write is ignored
+ * 				  and the newest valid record wins
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#ifndef JOURNAL_H_
+#define JOURNAL_H_
+
+/****************************************** Includes *********************************************/
+
+#include "std_types.h"
+#include "external_eeprom.h"
+
+/************************************************************************************************/
+
+
+/******************************************* Macros *********************************************/
+
+/* Number of data bytes in one record (Password length) */
+#define JOURNAL_PAYLOAD_SIZE		(5U)
+
+/*
+ * Record layout: Sequence (2 bytes, LSB first), Payload, CRC-8 of all bytes before it
+ * Record size MUST divide EEPROM_PAGE_SIZE so a record never crosses a page
+*/
+#define JOURNAL_RECORD_SIZE			(8U)
+
+/*
+ * EEPROM region of the journal (JOURNAL_RECORD_COUNT records from JOURNAL_START_ADDRESS)
+ * On-chip EEPROM: first half of it (64 records on ATmega32, 32 records on ATmega16)
+*/
+#if (EEPROM_BACKEND == EEPROM_BACKEND_INTERNAL)
+#define JOURNAL_START_ADDRESS		(0x0000U)
+#define JOURNAL_RECORD_COUNT		( (EEPROM_SIZE >= 1024UL) ? 64U : 32U )
+#else
+#define JOURNAL_START_ADDRESS		(0x0400U)
+#define JOURNAL_RECORD_COUNT		(64U)
+#endif
+
+/* Sequence number of an erased slot (0xFFFF), it is never written */
+#define JOURNAL_ERASED_SEQUENCE		(0xFFFFU)
+
+#if ( (2U + JOURNAL_PAYLOAD_SIZE + 1U) > JOURNAL_RECORD_SIZE )
+#error "JOURNAL_RECORD_SIZE is too small for JOURNAL_PAYLOAD_SIZE"
+#endif
+
+#if ( (EEPROM_PAGE_SIZE % JOURNAL_RECORD_SIZE) != 0U ) || ( (JOURNAL_START_ADDRESS % JOURNAL_RECORD_SIZE) != 0U )
+#error "Journal records must not cross EEPROM pages"
+#endif
+
+#if ( ( (JOURNAL_RECORD_COUNT * JOURNAL_RECORD_SIZE) % EEPROM_PAGE_SIZE ) != 0U ) || (JOURNAL_RECORD_COUNT > 255U)
+#error "Journal region must be whole pages and not more than 255 records"
+#endif
+
+#if ( JOURNAL_START_ADDRESS + (JOURNAL_RECORD_COUNT * JOURNAL_RECORD_SIZE) ) > EEPROM_SIZE
+#error "Journal region does not fit in the selected EEPROM"
+#endif
+
+/************************************************************************************************/
+
+
+/********************************** User Define Data Types **************************************/
+
+/********************************************************************************
+
+ [Enumuration Name]:		Journal_StatusType
+
+ [Enumuration Description]: Result of a journal operation
+
+*********************************************************************************/
+typedef enum{
+
+	JOURNAL_OK,
+	JOURNAL_EMPTY,			/* No valid record in the journal region	*/
+	JOURNAL_ERROR,			/* EEPROM access failed or record is broken	*/
+	JOURNAL_BUSY			/* A background append is still running		*/
+
+}Journal_StatusType;
+
+/************************************************************************************************/
+
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	Journal_init
+
+ [Description]:		Used to find the newest valid record by scanning the journal
+ 	 	 	 	 	region one page at a time (EEPROM_init must be called first)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			JOURNAL_OK if a record is found, JOURNAL_EMPTY if there is no
+ 	 	 	 	 	valid record, JOURNAL_ERROR if EEPROM can NOT be read
+**********************************************************************************/
+Journal_StatusType Journal_init(void);
+
+
+/********************************************************************************
+ [Function Name]:	Journal_read
+
+ [Description]:		Used to read the payload of the newest valid record
+
+ [Args]:			payload
+
+ [in]				None
+
+ [out]				payload: Array of JOURNAL_PAYLOAD_SIZE bytes to save the payload on it
+
+ [in/out]			None
+
+ [Returns]:			JOURNAL_OK if the payload is read, JOURNAL_EMPTY if there is
+ 	 	 	 	 	no valid record, JOURNAL_ERROR otherwise
+**********************************************************************************/
+Journal_StatusType Journal_read(uint8 *payload);
+
+
+/********************************************************************************
+ [Function Name]:	Journal_append
+
+ [Description]:		Used to save a new payload in the slot after the newest record
+ 	 	 	 	 	with the next sequence number (One page write)
+ 	 	 	 	 	- Older records stay valid till their slot is used again
+ 	 	 	 	 	- If the write fails, the previous record is still the newest
+
+ [Args]:			payload
+
+ [in]				payload: Array of JOURNAL_PAYLOAD_SIZE bytes to be saved
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			JOURNAL_OK if the record is written, JOURNAL_ERROR otherwise
+**********************************************************************************/
+Journal_StatusType Journal_append(const uint8 *payload);
+
+
+/********************************************************************************
+ [Function Name]:	Journal_appendAsync
+
+ [Description]:		Used to save a new payload like Journal_append, but the page
+ 	 	 	 	 	 	write and its write cycle run in the background
+ 	 	 	 	 	 	(EEPROM_writeBlockAsync), the record is the newest one only
+ 	 	 	 	 	 	after its write cycle ends
+ 	 	 	 	 	 	- Callback is called from an ISR with the result
+ 	 	 	 	 	 	- Journal_read and Journal_append wait for it to end
+
+ [Args]:			payload, f_ptr
+
+ [in]				payload: Array of JOURNAL_PAYLOAD_SIZE bytes to be saved
+ 	 	 	 	 	 	 	 	 (Copied, it can change after the return)
+ 	 	 	 	 	 	f_ptr:	 Pointer to the function called with the result
+ 	 	 	 	 	 	 	 	 (JOURNAL_OK or JOURNAL_ERROR)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			JOURNAL_OK if the write started, JOURNAL_BUSY if a background
+ 	 	 	 	 	 	append is running, JOURNAL_ERROR otherwise
+**********************************************************************************/
+Journal_StatusType Journal_appendAsync(const uint8 *payload, void (*f_ptr)(Journal_StatusType status));
+
+#endif /* JOURNAL_H_ */
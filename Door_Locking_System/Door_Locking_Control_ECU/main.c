@@ -13,38 +13,54 @@
 #include "micro_config.h"
 #include "uart.h"
 #include "timers.h"
+#include "i2c.h"
 #include "external_eeprom.h"
+#include "journal.h"
+#include "credentials.h"
 #include "Motors.h"
+#include "protocol.h"
+
 
 /***********************************************************************
- 	 	 	 	 	 	 	 Preprocessor Macros
+								Definitions
  ***********************************************************************/
-#define M1_READY 							0x10
-#define PASSWORD_NOT_SAVED					0x11
-#define NO_PREVIOS_PASSWORDS 				0x20
-#define PREVIOUS_PASSWORD_DETECTED			0x23
-#define NEW_PASSWORD_TO_BE_SAVED			0x21
-#define NEW_PASSWORD_SAVED_SUCCESSFULLY		0x22
-#define OVER_WRITE_OLD_PASSWORD				0x30
-#define STEP3_DOOR_MANIPULATION				0x40
-#define CHECK_PASSWORD						0x41
-#define CORRECT_PASSWORD					0x42
-#define INCORRECT_PASSWORD					0x43
-#define PASSWORD_WRONG_3_TIMES				0x44
-#define DOOR_OPEN							0x45
-#define DOOR_CLOSE							0x46
+
+/*
+ * Old fixed address of the password on External EEPROM (Before the journal)
+ * Read only while the journal is empty, first password change moves it to the journal
+*/
+#define PASSWORD_EEPROM_ADDRESS		(0x0311U)
+
+#if (JOURNAL_PAYLOAD_SIZE != PROTOCOL_PASSWORD_LENGTH) || (CREDENTIALS_CODE_LENGTH != PROTOCOL_PASSWORD_LENGTH)
+#error "Journal records and user codes must hold one password"
+#endif
+
+/*
+ * Access given by the last password check (g_passwordVerified)
+ * - User password:	 door only
+ * - Main password:	 door, password change and users update
+*/
+#define ACCESS_NONE					(0U)
+#define ACCESS_USER					(1U)
+#define ACCESS_ADMIN				(2U)
 
 
 /************************************************************************
   	  	  	  	  	  	  	  Function Prototypes
  ***********************************************************************/
 uint8 Read_eepromEmptyValue(void);
-void Write_eepromValue(uint8* arr);
-uint8 Compare_eepromMultipleValue(uint8* arr);
+uint8 Load_passwordShadow(void);
+uint8 Write_eepromValue(const uint8* arr);
+void Password_saved(Journal_StatusType status);
+void Password_saveResponse(void);
+uint8 Compare_eepromMultipleValue(const uint8* arr);
 void EEPROM_writeNewPassword(void);
-void EEPROM_overwritePassword(void);
-void Check_passwordEEPROM(void);
+void EEPROM_overwritePassword(const Protocol_FrameType* request);
+void Check_passwordEEPROM(const Protocol_FrameType* request);
+void Users_update(const Protocol_FrameType* request);
+void Door_request(void);
 void Timer1_INT(void);
+void Timer0_INT(void);
 void Theif_onTheSystem(void);
 void Door_on(void);
 void Door_off(void);
@@ -59,8 +75,37 @@ volatile uint8 g_timer1_10SecFlag = 0;
 /* Counter to count 1 Minute */
 volatile uint8 g_timer1_1MinFlag = 0;
 
-/* Flag to find the theif */
-uint8 g_theifFlag = 0;
+/*
+ * Access level to allow opening the door, saving a new password or updating users
+ * Set only after a correct password check (or if there is no saved password)
+ * and cleared after being used once
+*/
+uint8 g_passwordVerified = ACCESS_NONE;
+
+/*
+ * SRAM copy of the password saved on EEPROM (Write through)
+ * Loaded from EEPROM once, then copied from the written bytes after every
+ * password write (Loaded again only if a write fails)
+ * so password checks do not use the I2C bus
+*/
+uint8 g_passwordShadow[PROTOCOL_PASSWORD_LENGTH];
+
+/* Password being saved in the background, it goes to g_passwordShadow when the save ends */
+uint8 g_passwordToSave[PROTOCOL_PASSWORD_LENGTH];
+
+/* Flag set when g_passwordShadow has the EEPROM value */
+volatile uint8 g_passwordShadowLoaded = 0;
+
+/* Flag set from NEW_PASSWORD_TO_BE_SAVED request till its response is sent (Background save) */
+volatile uint8 g_passwordSavePending = 0;
+
+/* Flag set by Password_saved (ISR) when the background save ends, with the save result */
+volatile uint8 g_passwordSaveDone = 0;
+volatile Journal_StatusType g_passwordSaveStatus;
+
+/* NEW_PASSWORD_TO_BE_SAVED request of the background save (Other requests may come before it ends) */
+uint8 g_passwordSaveRequestType;
+uint8 g_passwordSaveRequestSequence;
 
 
 /************************************************************************
@@ -69,6 +114,8 @@ uint8 g_theifFlag = 0;
 int main(void)
 {
 
+	/* Frame received from HMI ECU */
+	Protocol_FrameType request;
 
 	/* UART Structure for its configurations */
 	UART_ConfigType uart_Struct;
@@ -77,10 +124,16 @@ int main(void)
 	/* Timer Structure for timer 1 configurations */
 	Timer_ConfigType timer1_Strut;
 
-	uart_Struct.BaudRate			= 9600;
+	/* Timer Structure for timer 0 configurations */
+	Timer_ConfigType timer0_Strut;
+
 	uart_Struct.InterruptMode		= POLLING;
 	uart_Struct.ParityMode			= NO_PARIT_BITS;
 	uart_Struct.StopBit				= STOP_BIT_1_BIT;
+	uart_Struct.RxBufferMode		= RX_BUFFER_ENABLE;
+	uart_Struct.TxBufferMode		= TX_BUFFER_ENABLE;
+	uart_Struct.MultiProcessorMode	= MPCM_SLAVE;
+	uart_Struct.Address				= PROTOCOL_CONTROL_ECU_ADDRESS;
 
 	/* Timer1 Tick every 1 Second */
 	timer1_Strut.TimerID 			= TIMER_ID_1;
@@ -91,6 +144,15 @@ int main(void)
 	timer1_Strut.InitialValue		= 0;
 	timer1_Strut.CompareValue		= 7900;
 
+	/* Timer0 Tick every 1 milli Second (8MHz / 64 / 125) for UART, TWI and EEPROM timing */
+	timer0_Strut.TimerID 			= TIMER_ID_0;
+	timer0_Strut.TimerMode			= CTC_MODE;
+	timer0_Strut.CompareMatchMode	= NORMAL;
+	timer0_Strut.OutputPin			= NONE;
+	timer0_Strut.Prescaler			= FCPU_OVER_64;
+	timer0_Strut.InitialValue		= 0;
+	timer0_Strut.CompareValue		= 124;
+
 	/* Enable Global Interrupt */
 	SREG |= (1<<7);
 
@@ -100,6 +162,12 @@ int main(void)
 	/* CallBack Function for timer 1 CTC Channel A Interrupt Function */
 	Timer1_setCallBack(Timer1_INT);
 
+	/* Timer 0 Initialization */
+	Timer_init(&timer0_Strut);
+
+	/* CallBack Function for timer 0 CTC Interrupt Function (Time base of UART, TWI and EEPROM) */
+	Timer0_setCallBack(Timer0_INT);
+
 	/* Buzzer Configurations */
 	DDRC |= (1 << PC2);
 	PORTC &= ~(1<<PC2);
@@ -113,132 +181,91 @@ int main(void)
 	/* UART initialization */
 	UART_init(&uart_Struct);
 
-	while(UART_recieveByte() != M1_READY){} // wait until MC2 is ready
-
 	/* Init EEPROM */
 	EEPROM_init();
 
+	/* Find the newest password record in the journal */
+	Journal_init();
+
+	/* Build the SRAM index of user passwords */
+	Credentials_init();
+
 	/*
-	 * Initially, EEPROM Suppose to be empty (0xFF)
-	 * so we need to put a password at first
+	 * Control ECU only answers requests of HMI ECU
+	 * every operation is one request frame and one response frame
 	 */
-	EEPROM_writeNewPassword();
-
 	while(1)
 	{
+		/* Background password save ended, answer its request from here (Not from the ISR) */
+		if(g_passwordSaveDone == 1){
 
-		/* Check if theif occured to start the program from first */
-		if(g_theifFlag == 1){
-
-			/* Wait till receivng the ACK From the HMI ECU */
-			while(UART_recieveByte() != M1_READY);
-
-			/* Check for received command if it is overwrite the old password or not */
-			if(UART_recieveByte() == OVER_WRITE_OLD_PASSWORD){
-
-				/*
-				 * Go to check password given from HMI ECU
-				 * with the old one in EEPROM
-				 */
-				do{
-					/*
-					 * Execute at least once
-					 * Used to hault on it till enter the right password
-					 */
-					Check_passwordEEPROM();
-				}while(g_theifFlag == 1);
-
-				/* Write new password */
-				EEPROM_overwritePassword();
-			}
+			Password_saveResponse();
+		}
 
-			/* Check for second command which is door manipulation */
-			if(UART_recieveByte() == STEP3_DOOR_MANIPULATION){
-
-				/*
-				 * Go to check password given from HMI ECU
-				 * with the old one in EEPROM
-				 */
-				do{
-					/*
-					 * Execute at least once
-					 * Used to hault on it till enter the right password
-					 */
-					Check_passwordEEPROM();
-				}while(g_theifFlag == 1);
-
-				/* Check for receiving Door open command */
-				if(UART_recieveByte() == DOOR_OPEN){
-
-					/* Opening the door for 10 seconds */
-					Door_on();
-				}
-				/* Closing the door for 10 seconds */
-				Door_off();
-			}
-			else{
-				/* Send error */
-				UART_sendByte(ERROR);
+		if(g_passwordSavePending == 1){
+
+			/* Wait for a short time only, so the response is sent as soon as the save ends */
+			if(Protocol_receiveRequestTimeout(&request, PROTOCOL_BYTE_TIMEOUT_MS) != PROTOCOL_FRAME_READY){
+
+				continue;
 			}
+		}
+		else{
 
-			/* Clear theif flag */
-			g_theifFlag = 0;
+			/* Wait for a valid request frame (Corrupted frames are discarded) */
+			Protocol_receiveFrame(&request);
 		}
 
-		else{
-			/* Wait till receivng the ACK From the HMI ECU */
-			while(UART_recieveByte() != M1_READY);
-
-			/* Check for received command if it is overwrite the old password or not */
-			if(UART_recieveByte() == OVER_WRITE_OLD_PASSWORD){
-
-				/*
-				 * Go to check password given from HMI ECU
-				 * with the old one in EEPROM
-				 */
-				do{
-					/*
-					 * Execute at least once
-					 * Used to hault on it till enter the right password
-					 */
-					Check_passwordEEPROM();
-				}while(g_theifFlag == 1);
-
-				/* Write new password */
-				EEPROM_overwritePassword();
-			}
+		switch(request.Type){
 
-			/* Check for second command which is door manipulation */
-			if(UART_recieveByte() == STEP3_DOOR_MANIPULATION){
-
-				/*
-				 * Go to check password given from HMI ECU
-				 * with the old one in EEPROM
-				 */
-				do{
-					/*
-					 * Execute at least once
-					 * Used to hault on it till enter the right password
-					 */
-					Check_passwordEEPROM();
-				}while(g_theifFlag == 1);
-
-				/* Check for receiving Door open command */
-				if(UART_recieveByte() == DOOR_OPEN){
-
-					/* Opening the door for 10 seconds */
-					Door_on();
-				}
-				/* Closing the door for 10 seconds */
-				Door_off();
-			}
-			else{
-				/* Send error */
-				UART_sendByte(ERROR);
+		case M1_READY:
+
+			/*
+			 * HMI ECU started
+			 * Initially, EEPROM Suppose to be empty (0xFF)
+			 * so we need to tell HMI ECU to put a password at first
+			 */
+			EEPROM_writeNewPassword();
+			break;
+
+		case NEW_PASSWORD_TO_BE_SAVED:
+
+			/* Request sent again while its password is being saved, its response is sent when saving ends */
+			if(g_passwordSavePending == 1){
+
+				break;
 			}
 
-			/* Clear theif flag */
-			g_theifFlag = 0;
+			/* Write new password */
+			EEPROM_overwritePassword(&request);
+			break;
+
+		case CHECK_PASSWORD:
+
+			/*
+			 * Go to check password given from HMI ECU
+			 * with the old one in EEPROM
+			 */
+			Check_passwordEEPROM(&request);
+			break;
+
+		case DOOR_OPEN:
+
+			/* Open then close the door if password is checked */
+			Door_request();
+			break;
+
+		case USER_ENROLL:
+		case USER_REMOVE:
+
+			/* Add, change or remove a user password if main password is checked */
+			Users_update(&request);
+			break;
+
+		default:
+
+			/* Unknown request, ignore it */
+			break;
 		}
 	}
 }
@@ -309,94 +336,122 @@ void Door_off(void){
 }
 
 
-void Check_passwordEEPROM(void){
+/********************************************************************************
+ [Function Name]:	Door_request
 
-	/* Iteration variable */
-	uint8 i = 0;
+ [Description]:		Used as a helper function to answer DOOR_OPEN request
+ 	 	 	 	 	Door is opened for 10 seconds then closed for 10 seconds
+ 	 	 	 	 	only if the password is checked correctly before it
 
-	/* Array to hold the password */
-	uint8 PasswordArr[5] = {0};
-	/*
-	 * Variable to hold how many times fucntion called itself
-	 * made static to hold its last value after recalling
-	 * Not a good behavior to make the function call itself due to
-	 * stack overflow problems, but here function call itself only twice
-	 * so it wont be a big problem
-	*/
-	static uint8 Flag_of_Calling = 0;
+ [Args]:			None
 
-	/* Wait untill HMI ECU get the password from the user */
-	while(UART_recieveByte() != CHECK_PASSWORD);
+ [in]				None
 
-	/* Recive the password byte by byte */
-	for(i = 0; i < 5; i++){
+ [out]				None
 
-		/*
-		 * Recive the password byte by byte
-		 * and save it on passwordArray
-		 */
-		PasswordArr[i] = UART_recieveByte();
+ [in/out]			None
+
+ [Returns]:			None
+ **********************************************************************************/
+void Door_request(void){
+
+	/* Password was NOT checked before this request (Main or user password) */
+	if(g_passwordVerified == ACCESS_NONE){
+
+		Protocol_sendFrame(INCORRECT_PASSWORD, NULL_PTR, 0);
+		return;
 	}
 
-	/* Check if received password from HMI ECU is Correct or not */
-	if (Compare_eepromMultipleValue(PasswordArr) == 5){
+	/* Clear the flag, next door request needs a new password check */
+	g_passwordVerified = ACCESS_NONE;
 
-		g_theifFlag = 0;
+	/* Tell HMI ECU that the door started opening */
+	Protocol_sendFrame(DOOR_OPEN, NULL_PTR, 0);
 
-		/* Correct Password */
-		UART_sendByte(M1_READY);
+	/* Opening the door for 10 seconds */
+	Door_on();
 
-		/* Sending an ACK TO HMI MCU to tell him that i will send commands */
+	/* Closing the door for 10 seconds */
+	Door_off();
+}
 
-		/* Sending an Correct Password ACK */
-		UART_sendByte(CORRECT_PASSWORD);
+/********************************************************************************
+ [Function Name]:	Check_passwordEEPROM
+
+ [Description]:		Used as a helper function to answer CHECK_PASSWORD request
+ 	 	 	 	 	by comparing the password in the frame with the saved one
+ 	 	 	 	 	- Correct:	 CORRECT_PASSWORD response
+ 	 	 	 	 	- Incorrect: INCORRECT_PASSWORD response
+ 	 	 	 	 	- Incorrect for 3 times consecutively: PASSWORD_WRONG_3_TIMES
+ 	 	 	 	 	  response and the alarm is turned on for 1 minute
+
+ [Args]:			request
+
+ [in]				request: Pointer to the received CHECK_PASSWORD frame
 
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+ **********************************************************************************/
+void Check_passwordEEPROM(const Protocol_FrameType* request){
+
+	/* Counter of consecutive wrong passwords */
+	static uint8 wrongPasswordCounter = 0;
+
+	/* Owner of a user password (Not used) */
+	uint8 userId;
+
+	g_passwordVerified = ACCESS_NONE;
+
+	if(request -> Length == PROTOCOL_PASSWORD_LENGTH){
+
+		/* Main password, then the user passwords (Index search, not a compare with every user) */
+		if(Compare_eepromMultipleValue(request -> Payload) == PROTOCOL_PASSWORD_LENGTH){
+
+			g_passwordVerified = ACCESS_ADMIN;
+		}
+		else if(Credentials_find(request -> Payload, &userId) == CREDENTIALS_OK){
+
+			g_passwordVerified = ACCESS_USER;
+		}
 	}
-	else
-	{
-		/* Sending an ACK TO HMI MCU to tell him that i will send commands */
-		UART_sendByte(M1_READY);
 
-		/* Incorrect Password! */
-		UART_sendByte(INCORRECT_PASSWORD);
+	/* Check if received password from HMI ECU is Correct or not */
+	if(g_passwordVerified != ACCESS_NONE){
+
+		/* Correct Password, allow next change password (Main password only) or door request */
+		wrongPasswordCounter = 0;
 
-		/* Increament calling flag */
-		Flag_of_Calling++;
+		/* Sending an Correct Password response */
+		Protocol_sendFrame(CORRECT_PASSWORD, NULL_PTR, 0);
+	}
+	else
+	{
+		/* Increament wrong passwords counter */
+		wrongPasswordCounter++;
 
 		/*
 		 * Incorrect Password!!
 		 * You Still Have 2 times
 		 * of putting the password correctly
 		 */
-		if(Flag_of_Calling <= 2){
-
+		if(wrongPasswordCounter <= 2){
 
-			/*
-			 * Not the best practice because if user put the password
-			 * wrong a lot of time, all this context switching
-			 * may goes into stackoverflow.
-			 * So, i should think about another way
-			 */
-			Check_passwordEEPROM();
+			/* Incorrect Password! */
+			Protocol_sendFrame(INCORRECT_PASSWORD, NULL_PTR, 0);
 		}
 		else
 		{
-			/* Clearing the recalling flag */
-			Flag_of_Calling = 0;
 			/* Three times password wrong consecutively */
-
-			/* Sending an ACK TO HMI MCU to tell him that i will send commands */
-			UART_sendByte(M1_READY);
+			wrongPasswordCounter = 0;
 
 			/* Incorrect Password for 3 times ! */
-			UART_sendByte(PASSWORD_WRONG_3_TIMES);
-
-			/* Set the theif flag to 1*/
-			g_theifFlag = 1;
+			Protocol_sendFrame(PASSWORD_WRONG_3_TIMES, NULL_PTR, 0);
 
 			/* Turn On Alarm for 1 Minute */
 			Theif_onTheSystem();
-
 		}
 	}
 
@@ -447,12 +502,13 @@ void Theif_onTheSystem(void){
 /********************************************************************************
  [Function Name]:	EEPROM_overwritePassword
 
- [Description]:		Used as a helper function to write the new password on the
- 	 	 	 	 	EEPROM
+ [Description]:		Used as a helper function to answer NEW_PASSWORD_TO_BE_SAVED
+ 	 	 	 	 	request by writing the new password on the EEPROM
+ 	 	 	 	 	(Only if the old password is checked or there is no old one)
 
- [Args]:			None
+ [Args]:			request
 
- [in]				None
+ [in]				request: Pointer to the received NEW_PASSWORD_TO_BE_SAVED frame
 
  [out]				None
 
@@ -460,61 +516,173 @@ void Theif_onTheSystem(void){
 
  [Returns]:			None
  **********************************************************************************/
-void EEPROM_overwritePassword(void){
+void EEPROM_overwritePassword(const Protocol_FrameType* request){
 
-	/* Array to hold the password */
-	uint8 passwordArray[5] = {0};
+	/* Owner of a user password */
+	uint8 userId;
 
-	/* Iterator Variable */
-	uint8 i = 0;
+	/* Main password was NOT checked before this request or frame is wrong */
+	if( (g_passwordVerified != ACCESS_ADMIN) || (request -> Length != PROTOCOL_PASSWORD_LENGTH) ){
 
-	/* Check if theif occured to start the program from first */
-	if(g_theifFlag == 1){
+		Protocol_sendFrame(PASSWORD_NOT_SAVED, NULL_PTR, 0);
+		return;
+	}
 
-		/* Clear the flag */
-		g_theifFlag = 0;
+	/* Clear the flag, next change needs a new password check */
+	g_passwordVerified = ACCESS_NONE;
 
+	/* Main password must NOT be a user password too (or EEPROM can NOT be read) */
+	if(Credentials_find(request -> Payload, &userId) != CREDENTIALS_NOT_FOUND){
+
+		Protocol_sendFrame(PASSWORD_NOT_SAVED, NULL_PTR, 0);
+		return;
 	}
 
-	/* Wait untill HMI ECU get the password from the user */
-	while(UART_recieveByte() != NEW_PASSWORD_TO_BE_SAVED);
+	/* Response of the background save answers this request */
+	g_passwordSaveRequestType		= request -> Type;
+	g_passwordSaveRequestSequence	= request -> Sequence;
 
-	/* Recive the password byte by byte */
-	for(i = 0; i < 5; i++){
+	/* Start saving the password on EEPROM, response is sent by Password_saveResponse when it ends */
+	if(Write_eepromValue(request -> Payload) == 0){
 
-		/*
-		 * Recive the password byte by byte
-		 * and save it on passwordArray
-		 */
-		passwordArray[i] = UART_recieveByte();
+		Protocol_sendFrame(PASSWORD_NOT_SAVED, NULL_PTR, 0);
 	}
+}
 
-	/* Start saving the password on EEPROM */
-	Write_eepromValue(passwordArray);
+/********************************************************************************
+ [Function Name]:	Password_saved
 
-	/* Sending to HMI ECU an ACK */
-	UART_sendByte(M1_READY);
+ [Description]:		Used as the callback of the background password save, called
+ 	 	 	 	 	from an ISR after the EEPROM write cycle ends (Page write and
+ 	 	 	 	 	write cycle were acknowledged by the EEPROM)
+ 	 	 	 	 	Only saves the result, the response is sent by the main loop
+ 	 	 	 	 	(UART can NOT send from here while interrupts are disabled)
 
-	/* Check if byte saved successfully or not */
-	if(Compare_eepromMultipleValue(passwordArray) == 5){
+ [Args]:			status
 
-		/* Send an ACK to HMI ECU That password saved successfully */
-		UART_sendByte(NEW_PASSWORD_SAVED_SUCCESSFULLY);
+ [in]				status: Result of the journal append
 
-	}
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+ **********************************************************************************/
+void Password_saved(Journal_StatusType status){
+
+	g_passwordSaveStatus	= status;
+	g_passwordSaveDone		= 1;
+}
+
+/********************************************************************************
+ [Function Name]:	Password_saveResponse
+
+ [Description]:		Used as a helper function to end the background password save
+ 	 	 	 	 	from the main loop after Password_saved is called
+ 	 	 	 	 	Updates the SRAM copy of the password from the saved bytes
+ 	 	 	 	 	and sends the response of NEW_PASSWORD_TO_BE_SAVED request
+ 	 	 	 	 	(With its SEQUENCE, other requests may be answered meanwhile)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+ **********************************************************************************/
+void Password_saveResponse(void){
 
+	/* Iteration variable */
+	uint8 i;
+
+	g_passwordSaveDone = 0;
+
+	if(g_passwordSaveStatus == JOURNAL_OK){
+
+		/* Write through, SRAM copy has the saved bytes (EEPROM is NOT read back) */
+		for(i = 0; i < PROTOCOL_PASSWORD_LENGTH; i++){
+
+			g_passwordShadow[i] = g_passwordToSave[i];
+		}
+
+		g_passwordShadowLoaded = 1;
+
+		/* Send an ACK to HMI ECU That password saved successfully */
+		Protocol_sendResponse(g_passwordSaveRequestType, g_passwordSaveRequestSequence,
+							  NEW_PASSWORD_SAVED_SUCCESSFULLY, NULL_PTR, 0);
+	}
 	else{
+
+		/* EEPROM may have a part of the record, SRAM copy is loaded again on the next check */
+		g_passwordShadowLoaded = 0;
+
 		/* Byte did NOT Saved successfully */
-		UART_sendByte(PASSWORD_NOT_SAVED);
+		Protocol_sendResponse(g_passwordSaveRequestType, g_passwordSaveRequestSequence,
+							  PASSWORD_NOT_SAVED, NULL_PTR, 0);
+	}
+
+	g_passwordSavePending = 0;
+}
+
+/********************************************************************************
+ [Function Name]:	Users_update
+
+ [Description]:		Used as a helper function to answer USER_ENROLL and USER_REMOVE
+ 	 	 	 	 	requests by updating the user passwords table on EEPROM
+ 	 	 	 	 	(Only if the main password is checked before the request)
+ 	 	 	 	 	- USER_ENROLL: Adds a user or changes its password
+ 	 	 	 	 	- USER_REMOVE: Removes a user
+ 	 	 	 	 	Response is USER_UPDATED or USER_NOT_UPDATED
+
+ [Args]:			request
+
+ [in]				request: Pointer to the received USER_ENROLL or USER_REMOVE frame
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+ **********************************************************************************/
+void Users_update(const Protocol_FrameType* request){
+
+	Credentials_StatusType status = CREDENTIALS_ERROR;
+
+	/* Main password was NOT checked before this request */
+	if(g_passwordVerified != ACCESS_ADMIN){
+
+		Protocol_sendFrame(USER_NOT_UPDATED, NULL_PTR, 0);
+		return;
+	}
+
+	/* Clear the flag, next update needs a new password check */
+	g_passwordVerified = ACCESS_NONE;
+
+	if( (request -> Type == USER_ENROLL) && (request -> Length == (1U + PROTOCOL_PASSWORD_LENGTH)) ){
+
+		/* User password must NOT be the main password */
+		if(Compare_eepromMultipleValue(&(request -> Payload[1])) != PROTOCOL_PASSWORD_LENGTH){
+
+			status = Credentials_enroll(request -> Payload[0], &(request -> Payload[1]));
+		}
 	}
+	else if( (request -> Type == USER_REMOVE) && (request -> Length == 1U) ){
 
+		status = Credentials_remove(request -> Payload[0]);
+	}
+
+	Protocol_sendFrame( ( (status == CREDENTIALS_OK) ? USER_UPDATED : USER_NOT_UPDATED ), NULL_PTR, 0);
 }
 
 /********************************************************************************
  [Function Name]:	EEPROM_writeNewPassword
 
- [Description]:		Used as a helper function to check if there is a previos
- 	 	 	 	 	password detected or not, if not so save the new one
+ [Description]:		Used as a helper function to answer M1_READY request (HMI ECU
+ 	 	 	 	 	started) by checking if there is a previos password detected
+ 	 	 	 	 	or not, if not so allow HMI ECU to save the new one
 
  [Args]:			None
 
@@ -533,30 +701,86 @@ void EEPROM_writeNewPassword(void){
 	 * to check if there is no previos
 	 * passwords saved
 	 * Default value = 0xFF
+	 * (Read once from EEPROM to the SRAM copy after reset)
 	 */
 
 	/* Check if 5 bytes are all equal to 0xFF */
-	if(	Read_eepromEmptyValue() == 5){
+	if(	Read_eepromEmptyValue() == PROTOCOL_PASSWORD_LENGTH){
 
-		/* Send an ACK to HMI ECU to know that there is not a previous passowrd */
-		UART_sendByte(NO_PREVIOS_PASSWORDS);
+		/* No old password to be checked, so allow saving the first one */
+		g_passwordVerified = ACCESS_ADMIN;
 
-		/* Write the password */
-		EEPROM_overwritePassword();
+		/* Send an ACK to HMI ECU to know that there is not a previous passowrd */
+		Protocol_sendFrame(NO_PREVIOS_PASSWORDS, NULL_PTR, 0);
 	}
 	else{
 
 		/* There is an old password detected ACK */
-		UART_sendByte(PREVIOUS_PASSWORD_DETECTED);
+		Protocol_sendFrame(PREVIOUS_PASSWORD_DETECTED, NULL_PTR, 0);
+
+	}
+
+}
+
+/********************************************************************************
+ [Function Name]:	Load_passwordShadow
+
+ [Description]:		Used as a helper function to read the saved password from
+ 	 	 	 	 	the newest journal record on EEPROM to its SRAM copy
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			1 if the SRAM copy is loaded, 0 if EEPROM read failed
+ **********************************************************************************/
+uint8 Load_passwordShadow(void){
+
+#if (EEPROM_BACKEND == EEPROM_BACKEND_INTERNAL)
+	uint8 i;
+#endif
 
+	switch(Journal_read(g_passwordShadow)){
+
+	case JOURNAL_OK:
+
+		g_passwordShadowLoaded = 1;
+		break;
+
+	case JOURNAL_EMPTY:
+
+#if (EEPROM_BACKEND == EEPROM_BACKEND_EXTERNAL)
+		/* No record yet, password may be at its old fixed address (0xFF if none) */
+		g_passwordShadowLoaded = ( (EEPROM_readBlock(PASSWORD_EEPROM_ADDRESS, g_passwordShadow, PROTOCOL_PASSWORD_LENGTH) == EEPROM_OK) ? 1 : 0 );
+#else
+		/* No record yet, On-chip EEPROM never had the old fixed address, so no password (0xFF) */
+		for(i = 0; i < PROTOCOL_PASSWORD_LENGTH; i++){
+
+			g_passwordShadow[i] = 0xFF;
+		}
+
+		g_passwordShadowLoaded = 1;
+#endif
+		break;
+
+	default:
+
+		g_passwordShadowLoaded = 0;
+		break;
 	}
 
+	return g_passwordShadowLoaded;
 }
 
 /********************************************************************************
  [Function Name]:	Read_eepromEmptyValue
 
  [Description]:		Used as a helper function to read the empty value (0xFF)
+ 	 	 	 	 	from the SRAM copy of the saved password
 
  [Args]:			None
 
@@ -570,28 +794,17 @@ void EEPROM_writeNewPassword(void){
  **********************************************************************************/
 uint8 Read_eepromEmptyValue(void){
 
-	uint8 valArray[5] = {0};
 	uint8 i = 0;
 	uint8 eepromEmptyFlag = 0;
 
-	//Read byte by byte from EEPROM
-	EEPROM_readByte(0x0311, &valArray[0]);
-	_delay_ms(10);
-
-	EEPROM_readByte(0x0312, &valArray[1]);
-	_delay_ms(10);
-
-	EEPROM_readByte(0x0313, &valArray[2]);
-	_delay_ms(10);
+	/* SRAM copy of the saved password, EEPROM is read only if it is not loaded */
+	if( (g_passwordShadowLoaded == 0) && (Load_passwordShadow() == 0) ){
 
-	EEPROM_readByte(0x0314, &valArray[3]);
-	_delay_ms(10);
-
-	EEPROM_readByte(0x0315, &valArray[4]);
-	_delay_ms(10);
+		return 0;
+	}
 
 	for(i = 0 ;i < 5; i++){
-		if(valArray[i] == 255){
+		if(g_passwordShadow[i] == 255){
 			eepromEmptyFlag += 1;
 		}
 	}
@@ -603,8 +816,9 @@ uint8 Read_eepromEmptyValue(void){
 /********************************************************************************
  [Function Name]:	Write_eepromValue
 
- [Description]:		Used as a helper function to write the value needed on EEPROM
- 	 	 	 	 	Byte by byte HARD CODED
+ [Description]:		Used as a helper function to start writing the value needed
+ 	 	 	 	 	on EEPROM in the background (Appended to the password journal)
+ 	 	 	 	 	Password_saved is called when it ends
 
  [Args]:			arr
 
@@ -615,43 +829,36 @@ uint8 Read_eepromEmptyValue(void){
 
  [in/out]			None
 
- [Returns]:			None
+ [Returns]:			1 if writing started, 0 otherwise
  **********************************************************************************/
-void Write_eepromValue(uint8* arr){
+uint8 Write_eepromValue(const uint8* arr){
 
-	/* Write Password Byte by byte */
-	EEPROM_writeByte((0x0311), arr[0]);
-
-	_delay_ms(10);
-
-	/* Write Password Byte by byte */
-	EEPROM_writeByte((0x0312), arr[1]);
-
-	_delay_ms(10);
-
-
-	/* Write Password Byte by byte */
-	EEPROM_writeByte((0x0313), arr[2]);
+	/* Iteration variable */
+	uint8 i;
 
-	_delay_ms(10);
+	/* Kept for the SRAM copy as the caller buffer is used again before the save ends */
+	for(i = 0; i < PROTOCOL_PASSWORD_LENGTH; i++){
 
-	/* Write Password Byte by byte */
-	EEPROM_writeByte((0x0314), arr[3]);
+		g_passwordToSave[i] = arr[i];
+	}
 
-	_delay_ms(10);
+	g_passwordSavePending = 1;
 
+	/* Append the Password as a new journal record (Previous record stays valid if the write fails) */
+	if(Journal_appendAsync(arr, Password_saved) != JOURNAL_OK){
 
-	/* Write Password Byte by byte */
-	EEPROM_writeByte((0x0315), arr[4]);
+		g_passwordSavePending = 0;
+		return 0;
+	}
 
-	_delay_ms(10);
+	return 1;
 }
 
 /********************************************************************************
  [Function Name]:	Compare_eepromMultipleValue
 
  [Description]:		Used as a helper function compare a given value with the value
- 	 	 	 	 	saved now on EEPROM
+ 	 	 	 	 	saved now on EEPROM (Its SRAM copy, no I2C bus access)
 
  [Args]:			arr
 
@@ -663,35 +870,54 @@ void Write_eepromValue(uint8* arr){
 
  [Returns]:			Count of equal Flag (it should be 5 if all 5 slots are the same)
  **********************************************************************************/
-uint8 Compare_eepromMultipleValue(uint8* arr){
+uint8 Compare_eepromMultipleValue(const uint8* arr){
 
-	uint8 valArray[5] = {0};
 	uint8 i = 0;
 	uint8 eepromEqualityFlag = 0;
-	//Read byte by byte from EEPROM
-	EEPROM_readByte(0x0311, &valArray[0]);
-	_delay_ms(10);
 
-	EEPROM_readByte(0x0312, &valArray[1]);
-	_delay_ms(10);
+	/* SRAM copy of the saved password, EEPROM is read only if it is not loaded */
+	if( (g_passwordShadowLoaded == 0) && (Load_passwordShadow() == 0) ){
 
-	EEPROM_readByte(0x0313, &valArray[2]);
-	_delay_ms(10);
-
-	EEPROM_readByte(0x0314, &valArray[3]);
-	_delay_ms(10);
-
-	EEPROM_readByte(0x0315, &valArray[4]);
-	_delay_ms(10);
+		return 0;
+	}
 
 	for(i = 0 ;i < 5; i++){
-		if(valArray[i] == arr[i]){
+		if(g_passwordShadow[i] == arr[i]){
 			eepromEqualityFlag += 1;
 		}
 	}
 	return eepromEqualityFlag;
 }
 
+/********************************************************************************
+ [Function Name]:	Timer0_INT
+
+ [Description]:		Used as the Handler function givin to Timer0 CTC ISR by
+ 	 	 	 	 	callback technique (1 milli Second time base of UART
+ 	 	 	 	 	timeouts, TWI timeouts and EEPROM background writes)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+ **********************************************************************************/
+void Timer0_INT(void){
+
+	/* Byte timeouts of UART */
+	UART_timeoutTick();
+
+	/* Stuck transactions of TWI */
+	TWI_timeoutTick();
+
+	/* ACK polls of background EEPROM writes */
+	EEPROM_writeCycleTick();
+}
+
 /********************************************************************************
  [Function Name]:	Timer1_INT
 
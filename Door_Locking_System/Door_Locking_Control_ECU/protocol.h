@@ -0,0 +1,385 @@
+ /******************************************************************************
+ *
+ * Module: Protocol
+ *
+ * File Name: protocol.h
+ *
+ * Description: Header file for the framed communication protocol between
+ * 				HMI ECU and Control ECU (Shared between both ECUs)
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *
+ * Note: Frame Format
+ * 		+------+------+----------+--------+-------------------+-------+
+ * 		| SYNC | TYPE | SEQUENCE | LENGTH | PAYLOAD (0 .. N)  | CRC-8 |
+ * 		+------+------+----------+--------+-------------------+-------+
+ * 		CRC-8 is calculated over TYPE, SEQUENCE, LENGTH and PAYLOAD
+ * 		Response has the same SEQUENCE of its request, a repeated request
+ * 		(same SEQUENCE) is answered again without being executed twice
+ *******************************************************************************/
+
+#ifndef PROTOCOL_H_
+#define PROTOCOL_H_
+
+/****************************************** Includes *********************************************/
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "uart.h"
+#include "crc.h"
+
+/************************************************************************************************/
+
+
+/******************************************* Macros *********************************************/
+
+/* First byte of every frame, used to resynchronize after a corrupted frame */
+#define PROTOCOL_SYNC_BYTE					(0x7EU)
+
+/* Maximum number of payload bytes in one frame */
+#define PROTOCOL_MAX_PAYLOAD				(8U)
+
+/* Number of frame bytes other than the payload (SYNC, TYPE, SEQUENCE, LENGTH and CRC) */
+#define PROTOCOL_FRAME_OVERHEAD				(5U)
+
+/*
+ * Addresses on the Multi-processor UART bus (One HMI ECU master, many Control ECUs)
+ * PROTOCOL_NO_DESTINATION is for a point to point line (No address frames)
+*/
+#define PROTOCOL_NO_DESTINATION				(0x00U)
+#define PROTOCOL_CONTROL_ECU_ADDRESS		(0x01U)
+
+/* Number of digits of the password sent in one frame */
+#define PROTOCOL_PASSWORD_LENGTH			(5U)
+
+/* Maximum time between two bytes of the same frame before dropping it (milli seconds) */
+#define PROTOCOL_BYTE_TIMEOUT_MS			(10U)
+
+/* Maximum time to wait for the response of a request (milli seconds) */
+#define PROTOCOL_RESPONSE_TIMEOUT_MS		(250U)
+
+/* Number of times a request is sent again if its response is not received */
+#define PROTOCOL_MAX_RETRIES				(3U)
+
+/*
+ * Frame types (Requests from HMI ECU and responses from Control ECU)
+ * Same values as the old single byte commands
+*/
+#define M1_READY 							0x10
+#define PASSWORD_NOT_SAVED					0x11
+#define NO_PREVIOS_PASSWORDS 				0x20
+#define NEW_PASSWORD_TO_BE_SAVED			0x21
+#define NEW_PASSWORD_SAVED_SUCCESSFULLY		0x22
+#define PREVIOUS_PASSWORD_DETECTED			0x23
+#define CHECK_PASSWORD						0x41
+#define CORRECT_PASSWORD					0x42
+#define INCORRECT_PASSWORD					0x43
+#define PASSWORD_WRONG_3_TIMES				0x44
+#define DOOR_OPEN							0x45
+#define USER_ENROLL							0x50	/* Payload: User ID, User password	*/
+#define USER_REMOVE							0x51	/* Payload: User ID					*/
+#define USER_UPDATED						0x52
+#define USER_NOT_UPDATED					0x53
+
+/* Type given to the response when Control ECU did NOT answer at all */
+#define PROTOCOL_NO_RESPONSE				0x00
+
+/************************************************************************************************/
+
+
+/********************************** User Define Data Types **************************************/
+
+/********************************************************************************
+
+ [Enumuration Name]:		Protocol_StatusType
+
+ [Enumuration Description]: Result of giving a byte to the frame parser
+
+*********************************************************************************/
+typedef enum{
+
+	PROTOCOL_FRAME_INCOMPLETE,
+	PROTOCOL_FRAME_READY,
+	PROTOCOL_FRAME_CRC_ERROR,
+	PROTOCOL_FRAME_LENGTH_ERROR,
+	PROTOCOL_TIMEOUT
+
+}Protocol_StatusType;
+
+
+/********************************************************************************
+
+ [Enumuration Name]:		Protocol_ParserStateType
+
+ [Enumuration Description]: States of the streaming frame parser
+
+*********************************************************************************/
+typedef enum{
+
+	PARSER_WAIT_SYNC,
+	PARSER_WAIT_TYPE,
+	PARSER_WAIT_SEQUENCE,
+	PARSER_WAIT_LENGTH,
+	PARSER_WAIT_PAYLOAD,
+	PARSER_WAIT_CRC
+
+}Protocol_ParserStateType;
+
+
+/********************************************************************************
+
+ [Structure Name]: 		  Protocol_FrameType
+
+ [Structure Description]: Structure which holds one decoded frame
+
+*********************************************************************************/
+typedef struct{
+
+	uint8	Type;								/* You can find this value @Frame types
+												   Used to decide the request/response */
+
+	uint8	Sequence;							/* Request number, used to match the response
+												   and to detect repeated requests */
+
+	uint8	Length;								/* Number of valid bytes in Payload */
+
+	uint8	Payload[PROTOCOL_MAX_PAYLOAD];		/* Frame data (Password digits for example) */
+
+}Protocol_FrameType;
+
+
+/********************************************************************************
+
+ [Structure Name]: 		  Protocol_ParserType
+
+ [Structure Description]: Structure which holds the state of a streaming parser
+ 	 	 	 	 	 	  (Bytes are given one by one as they are received)
+
+*********************************************************************************/
+typedef struct{
+
+	Protocol_ParserStateType	State;			/* Current parser state */
+
+	uint8						Index;			/* Number of payload bytes received */
+
+	uint8						Crc;			/* Running CRC of the frame */
+
+	Protocol_FrameType			Frame;			/* Frame being decoded */
+
+}Protocol_ParserType;
+
+/***********************************************************************************************/
+
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	Protocol_initParser
+
+ [Description]:		Used to reset a frame parser to wait for a new frame
+
+ [Args]:			parser_Ptr
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			parser_Ptr: Pointer to the parser to be reset
+
+ [Returns]:			None
+**********************************************************************************/
+void Protocol_initParser(Protocol_ParserType *parser_Ptr);
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_parseByte
+
+ [Description]:		Used to give one received byte to the streaming parser
+ 	 	 	 	 	- Bytes before SYNC byte are ignored
+ 	 	 	 	 	- Too long or corrupted frames are rejected directly and the
+ 	 	 	 	 	  parser waits for the next SYNC byte
+
+ [Args]:			parser_Ptr, data
+
+ [in]				data: Received byte
+
+ [out]				None
+
+ [in/out]			parser_Ptr: Pointer to the parser
+ 	 	 	 	 	(parser_Ptr -> Frame is valid when PROTOCOL_FRAME_READY returned)
+
+ [Returns]:			Status of the parser @Protocol_StatusType
+**********************************************************************************/
+Protocol_StatusType Protocol_parseByte(Protocol_ParserType *parser_Ptr, uint8 data);
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_sendFrame
+
+ [Description]:		Used to send one whole response frame through UART
+ 	 	 	 	 	- It has the SEQUENCE of the last received request
+ 	 	 	 	 	- It is saved to be sent again if the request is repeated
+
+ [Args]:			type, payload_Ptr, length
+
+ [in]				type:		 Frame type @Frame types
+ 	 	 	 	 	payload_Ptr: Pointer to payload bytes (NULL_PTR if length is 0)
+ 	 	 	 	 	length:		 Number of payload bytes (PROTOCOL_MAX_PAYLOAD max)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Protocol_sendFrame(uint8 type, const uint8 *payload_Ptr, uint8 length);
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_sendResponse
+
+ [Description]:		Used to send one whole response frame of a given request
+ 	 	 	 	 	through UART (A request answered later, after other ones)
+ 	 	 	 	 	- It has the SEQUENCE of that request
+ 	 	 	 	 	- It is saved to be sent again if that request is repeated
+
+ [Args]:			requestType, requestSequence, type, payload_Ptr, length
+
+ [in]				requestType:	 Frame type of the answered request
+ 	 	 	 	 	requestSequence: Sequence of the answered request
+ 	 	 	 	 	type:			 Frame type @Frame types
+ 	 	 	 	 	payload_Ptr:	 Pointer to payload bytes (NULL_PTR if length is 0)
+ 	 	 	 	 	length:			 Number of payload bytes (PROTOCOL_MAX_PAYLOAD max)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Protocol_sendResponse(uint8 requestType, uint8 requestSequence, uint8 type, const uint8 *payload_Ptr, uint8 length);
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_receiveFrame
+
+ [Description]:		Used to wait until a new valid request frame is received
+ 	 	 	 	 	- Corrupted or stalled frames are discarded
+ 	 	 	 	 	- Repeated requests are answered with the saved response
+ 	 	 	 	 	  directly without returning them
+
+ [Args]:			frame_Ptr
+
+ [in]				None
+
+ [out]				frame_Ptr: Pointer to frame structure to save the frame on it
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Protocol_receiveFrame(Protocol_FrameType *frame_Ptr);
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_receiveFrameTimeout
+
+ [Description]:		Used to wait for a bounded time until a valid frame is received
+ 	 	 	 	 	(Corrupted or stalled frames are discarded)
+
+ [Args]:			frame_Ptr, timeout
+
+ [in]				timeout:   Maximum time to wait for every byte in milli seconds
+
+ [out]				frame_Ptr: Pointer to frame structure to save the frame on it
+
+ [in/out]			None
+
+ [Returns]:			PROTOCOL_FRAME_READY or PROTOCOL_TIMEOUT
+**********************************************************************************/
+Protocol_StatusType Protocol_receiveFrameTimeout(Protocol_FrameType *frame_Ptr, uint16 timeout);
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_receiveRequestTimeout
+
+ [Description]:		Used to wait for a bounded time until a new valid request
+ 	 	 	 	 	frame is received (Same as Protocol_receiveFrame), so the
+ 	 	 	 	 	caller can do other work between the requests
+ 	 	 	 	 	- Repeated requests are answered with the saved response
+ 	 	 	 	 	  directly without returning them
+
+ [Args]:			frame_Ptr, timeout
+
+ [in]				timeout:   Maximum time to wait for every byte in milli seconds
+
+ [out]				frame_Ptr: Pointer to frame structure to save the frame on it
+
+ [in/out]			None
+
+ [Returns]:			PROTOCOL_FRAME_READY or PROTOCOL_TIMEOUT
+**********************************************************************************/
+Protocol_StatusType Protocol_receiveRequestTimeout(Protocol_FrameType *frame_Ptr, uint16 timeout);
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_request
+
+ [Description]:		Used to send a request frame and wait for its response frame
+ 	 	 	 	 	(One round trip per operation)
+ 	 	 	 	 	- Request is sent again if no response in PROTOCOL_RESPONSE_TIMEOUT_MS
+ 	 	 	 	 	  for PROTOCOL_MAX_RETRIES times
+ 	 	 	 	 	- Responses of old requests are ignored
+
+ [Args]:			type, payload_Ptr, length, reply_Ptr
+
+ [in]				type:		 Request frame type @Frame types
+ 	 	 	 	 	payload_Ptr: Pointer to payload bytes (NULL_PTR if length is 0)
+ 	 	 	 	 	length:		 Number of payload bytes
+
+ [out]				reply_Ptr:	 Pointer to frame structure to save the response on it
+ 	 	 	 	 	 	 	 (Type is PROTOCOL_NO_RESPONSE if there is no response)
+
+ [in/out]			None
+
+ [Returns]:			PROTOCOL_FRAME_READY or PROTOCOL_TIMEOUT
+**********************************************************************************/
+Protocol_StatusType Protocol_request(uint8 type, const uint8 *payload_Ptr, uint8 length, Protocol_FrameType *reply_Ptr);
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_setDestination
+
+ [Description]:		Used by the master to choose which Control ECU receives the
+ 	 	 	 	 	next frames, an address frame is sent before every frame
+ 	 	 	 	 	(UART must be in MPCM_MASTER mode)
+
+ [Args]:			address
+
+ [in]				address: Address of the Control ECU on the bus
+ 	 	 	 	 	 	 	 (PROTOCOL_NO_DESTINATION for a point to point line)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Protocol_setDestination(uint8 address);
+
+
+#endif /* PROTOCOL_H_ */
@@ -200,8 +200,11 @@ void Timer_init(const Timer_ConfigType * config_Ptr){
 			TIMSK |= (1 << OCIE0);
 		}
 
-		/* Choose Timer Mode (Normal or CTC Mode) */
-		TCCR0 = ( (TCCR0 & ~(0x48) ) | ( ( (config_Ptr -> TimerMode) << WGM00) ) );
+		/*
+		 * Choose Timer Mode (Normal or CTC Mode)
+		 * CTC Mode is WGM01 = 1 & WGM00 = 0 (WGM00 alone is PWM Phase Correct Mode)
+		*/
+		TCCR0 = ( (TCCR0 & ~(0x48) ) | ( ( (config_Ptr -> TimerMode) & 0x01) << WGM01 ) );
 
 
 		/* Choose which operation should be done when compare match occures */
@@ -334,8 +337,11 @@ void Timer_init(const Timer_ConfigType * config_Ptr){
 			TIMSK |= (1 << OCIE2);
 		}
 
-		/* Choose Timer Mode (Normal or CTC Mode) */
-		TCCR2 |= ( (TCCR2 & ~(0x48) ) | ( ( (config_Ptr -> TimerMode) << WGM20) ) );
+		/*
+		 * Choose Timer Mode (Normal or CTC Mode)
+		 * CTC Mode is WGM21 = 1 & WGM20 = 0 (WGM20 alone is PWM Phase Correct Mode)
+		*/
+		TCCR2 = ( (TCCR2 & ~(0x48) ) | ( ( (config_Ptr -> TimerMode) & 0x01) << WGM21 ) );
 
 		/* Choose which operation should be done when compare match occures */
 		TCCR2 = ( (TCCR2 & 0xCF) | (config_Ptr -> CompareMatchMode) << COM20);
@@ -27,12 +27,342 @@ static volatile void (*g_callBackPtrUartRx)(void) = NULL_PTR;
 /* Global variables to hold the address of the call back function for UART Tx Interrupt in the application */
 static volatile void (*g_callBackPtrUartTx)(void) = NULL_PTR;
 
+/* Global variable to hold the Rx buffer mode chosen in UART_init */
+static UART_RxBufferModeType g_rxBufferMode = RX_BUFFER_DISABLE;
+
+/* Rx ring buffer filled by Rx ISR in RX_BUFFER_ENABLE mode */
+static volatile uint8 g_rxBuffer[UART_RX_BUFFER_SIZE];
+
+/*
+ * Free running indices of the Rx ring buffer
+ * Head is written only by Rx ISR and Tail is written only by the application
+ * so no need to disable interrupts while reading them (8 bit access is atomic)
+*/
+static volatile uint8 g_rxHead = 0;
+static volatile uint8 g_rxTail = 0;
+
+/* Global variables to hold the address of the call back function when Tx ring buffer is drained */
+static volatile void (*g_callBackPtrUartTxDrain)(void) = NULL_PTR;
+
+/* Global variable to hold the Tx buffer mode chosen in UART_init */
+static UART_TxBufferModeType g_txBufferMode = TX_BUFFER_DISABLE;
+
+/* Tx ring buffer drained by Data Register Empty ISR in TX_BUFFER_ENABLE mode */
+static volatile uint8 g_txBuffer[UART_TX_BUFFER_SIZE];
+
+/*
+ * Free running indices of the Tx ring buffer
+ * Head is written only by the application and Tail is written only by UDRE ISR
+*/
+static volatile uint8 g_txHead = 0;
+static volatile uint8 g_txTail = 0;
+
+/* Flag to know that a byte has been written to UDR since last flush */
+static volatile uint8 g_txWritten = FALSE;
+
+/* Block sent by UART_sendBuffer directly from the caller buffer (NULL_PTR if no block) */
+static const uint8 * volatile g_txBlockPtr = NULL_PTR;
+static volatile uint8 g_txBlockLength = 0;
+static volatile uint8 g_txBlockIndex = 0;
+
+/* Global variables to hold the address of the call back function when the Tx block is sent */
+static volatile void (*g_callBackPtrUartTxBlock)(void) = NULL_PTR;
+
+/* Block filled by UART_receiveBuffer directly in the caller buffer (NULL_PTR if no block) */
+static uint8 * volatile g_rxBlockPtr = NULL_PTR;
+static volatile uint8 g_rxBlockLength = 0;
+static volatile uint8 g_rxBlockIndex = 0;
+
+/* Rx Interrupt state before UART_receiveBuffer enabled it (restored when the block ends) */
+static volatile uint8 g_rxBlockIntEnabled = FALSE;
+
+/* Global variables to hold the address of the call back function when the Rx block is received */
+static volatile void (*g_callBackPtrUartRxBlock)(void) = NULL_PTR;
+
+/* Multi-processor mode chosen in UART_init and own address in MPCM_SLAVE mode */
+static UART_MultiProcessorModeType g_mpcmMode = MPCM_DISABLE;
+static uint8 g_mpcmAddress = 0;
+
+/* Link statistics counted by the driver, read by UART_getStatistics */
+static volatile UART_StatisticsType g_statistics;
+
+/* Remaining ticks of the running timeout, decremented by UART_timeoutTick */
+static volatile uint16 g_timeoutTicks = 0;
+
+/* Flag set by UART_timeoutTick when the running timeout ends (8 bit so atomic to read) */
+static volatile uint8 g_timeoutExpired = FALSE;
+
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Read the received byte from UDR register and count its errors
+ * UCSRA error flags (FE, DOR, PE) belong to the byte on the top of the
+ * receive buffer so they MUST be read before UDR
+*/
+static uint8 UART_readData(void){
+
+	/* Error flags of the received byte */
+	uint8 status = UCSRA;
+
+	if(BIT_IS_SET(status,DOR)){
+
+		g_statistics.OverrunErrors++;
+	}
+
+	if(BIT_IS_SET(status,FE)){
+
+		g_statistics.FramingErrors++;
+	}
+
+	if(BIT_IS_SET(status,PE)){
+
+		g_statistics.ParityErrors++;
+	}
+
+	g_statistics.BytesReceived++;
+
+	return UDR;
+}
+
+
+/*
+ * Check the 9th bit of the received character in MPCM_SLAVE mode
+ * An address frame is read here to select or deselect this slave:
+ * - MPCM = 0: own or broadcast address, next data frames are received
+ * - MPCM = 1: another slave address, hardware ignores data frames (No Rx interrupt)
+ * RXB8 MUST be read before UDR as reading UDR moves the receive buffer
+ * Returns TRUE if the character was an address frame (Not for the application)
+*/
+static uint8 UART_checkAddressFrame(void){
+
+	/* Received address */
+	uint8 address;
+
+	if( (g_mpcmMode != MPCM_SLAVE) || BIT_IS_CLEAR(UCSRB,RXB8) ){
+
+		return FALSE;
+	}
+
+	address = UART_readData();
+
+	/* Write U2X and MPCM only (Writing one to TXC flag clears it) */
+	if( (address == g_mpcmAddress) || (address == UART_MPCM_BROADCAST_ADDRESS) ){
+
+		UCSRA = (UCSRA & (1 << U2X));
+	}
+	else{
+
+		UCSRA = (UCSRA & (1 << U2X)) | (1 << MPCM);
+	}
+
+	return TRUE;
+}
+
+
+/*
+ * Move the oldest queued byte to UDR register
+ * Called from UDRE ISR or from UART_sendByte if the buffer is full while
+ * Global Interrupts are disabled (to avoid dead lock)
+*/
+static void UART_txDrainStep(void){
+
+	/* Put the byte on UDR and move the tail to free its place */
+	UDR = g_txBuffer[g_txTail & UART_TX_BUFFER_MASK];
+	g_txTail++;
+	g_statistics.BytesSent++;
+
+	/*
+	 * Clear TXC flag (by writing one) to be able to know when the shift out ends
+	 * Only U2X and MPCM are written back (FE, DOR and PE are read only)
+	*/
+	UCSRA = (UCSRA & ((1 << U2X) | (1 << MPCM))) | (1 << TXC);
+
+	/* Buffer is empty now */
+	if(g_txHead == g_txTail){
+
+		/* Disable UDRE Interrupt till new bytes are queued */
+		CLEAR_BIT(UCSRB,UDRIE);
+
+		/* Tell the application that all the queued bytes are sent */
+		if(g_callBackPtrUartTxDrain != NULL_PTR){
+
+			(*g_callBackPtrUartTxDrain)();
+		}
+	}
+}
+
+
+/*
+ * Move the next byte of the Tx block to UDR register
+ * Called from UDRE ISR or from UART_txPollStep
+*/
+static void UART_txBlockStep(void){
+
+	/* Pointer to the block callback to call it after the block is released */
+	volatile void (*callBack)(void);
+
+	UDR = g_txBlockPtr[g_txBlockIndex];
+	g_txBlockIndex++;
+	g_statistics.BytesSent++;
+
+	/*
+	 * Clear TXC flag (by writing one) to be able to know when the shift out ends
+	 * Only U2X and MPCM are written back (FE, DOR and PE are read only)
+	*/
+	UCSRA = (UCSRA & ((1 << U2X) | (1 << MPCM))) | (1 << TXC);
+
+	/* Last byte of the block */
+	if(g_txBlockIndex == g_txBlockLength){
+
+		callBack		= g_callBackPtrUartTxBlock;
+		g_txBlockPtr	= NULL_PTR;
+
+		/* Keep UDRE Interrupt enabled only if bytes are queued behind the block */
+		if(g_txHead == g_txTail){
+
+			CLEAR_BIT(UCSRB,UDRIE);
+		}
+
+		/* Tell the application that its buffer can be used again */
+		if(callBack != NULL_PTR){
+
+			(*callBack)();
+		}
+	}
+}
+
+
+/*
+ * Do the work of UDRE ISR by hand while Global Interrupts are disabled
+ * (Called from an ISR for example), so waiting for the Tx block or the
+ * queued bytes is not a dead lock
+*/
+static void UART_txPollStep(void){
+
+	if( BIT_IS_CLEAR(SREG,7) && BIT_IS_SET(UCSRA,UDRE) ){
+
+		/* Tx block is sent first as bytes are queued behind it */
+		if(g_txBlockPtr != NULL_PTR){
+
+			UART_txBlockStep();
+		}
+		else if(g_txHead != g_txTail){
+
+			UART_txDrainStep();
+		}
+		else{
+
+			/* Nothing to be sent, disable UDRE Interrupt */
+			CLEAR_BIT(UCSRB,UDRIE);
+		}
+	}
+}
+
+
+/*
+ * Save one received byte in the Rx block
+ * Called from Rx ISR or from UART_receiveBuffer while Global Interrupts are disabled
+*/
+static void UART_rxBlockStep(uint8 data){
+
+	/* Pointer to the block callback to call it after the block is released */
+	volatile void (*callBack)(void);
+
+	g_rxBlockPtr[g_rxBlockIndex] = data;
+	g_rxBlockIndex++;
+
+	/* Last byte of the block */
+	if(g_rxBlockIndex == g_rxBlockLength){
+
+		callBack		= g_callBackPtrUartRxBlock;
+		g_rxBlockPtr	= NULL_PTR;
+
+		/* Rx Interrupt was enabled only for this block */
+		if(g_rxBlockIntEnabled == FALSE){
+
+			CLEAR_BIT(UCSRB,RXCIE);
+		}
+
+		/* Tell the application that its buffer is filled */
+		if(callBack != NULL_PTR){
+
+			(*callBack)();
+		}
+	}
+}
+
+
+/*
+ * Start counting a new timeout in milli seconds
+ * Interrupts are disabled while writing the 16 bit counter as
+ * UART_timeoutTick may change it from the timer ISR
+*/
+static void UART_startTimeout(uint16 timeout){
+
+	/* Save Global Interrupt state to restore it */
+	uint8 sreg = SREG;
+
+	cli();
+
+	g_timeoutTicks		= ( (timeout + UART_TIMEOUT_TICK_MS - 1U) / UART_TIMEOUT_TICK_MS );
+	g_timeoutExpired	= ( (g_timeoutTicks == 0) ? TRUE : FALSE );
+
+	SREG = sreg;
+}
+
 
 /*******************************************************************************
  *                       Interrupt Service Routines                            *
  *******************************************************************************/
 ISR(USART_RXC_vect){
 
+	/* Byte received from UDR register */
+	uint8 data;
+
+	/* Address frames select this slave and are not given to the application */
+	if(UART_checkAddressFrame() == TRUE){
+
+		return;
+	}
+
+	/* Rx block is waiting for bytes, save the byte directly in the caller buffer */
+	if(g_rxBlockPtr != NULL_PTR){
+
+		UART_rxBlockStep(UART_readData());
+		return;
+	}
+
+	/* Check if Rx ring buffer mode is activated */
+	if(g_rxBufferMode == RX_BUFFER_ENABLE){
+
+		/* Read UDR first to clear RXC flag (Must be read inside ISR) */
+		data = UART_readData();
+
+		/*
+		 * Check if there is a space on the buffer
+		 * if buffer is full the byte will be dropped
+		*/
+		if( (uint8)(g_rxHead - g_rxTail) < UART_RX_BUFFER_SIZE ){
+
+			/* Save the byte and move the head */
+			g_rxBuffer[g_rxHead & UART_RX_BUFFER_MASK] = data;
+			g_rxHead++;
+
+			/* Save the highest occupancy to know if the buffer size is enough */
+			if( (uint8)(g_rxHead - g_rxTail) > g_statistics.MaxRxOccupancy ){
+
+				g_statistics.MaxRxOccupancy = (uint8)(g_rxHead - g_rxTail);
+			}
+		}
+		else{
+
+			g_statistics.DroppedBytes++;
+		}
+	}
+
 	/*
 	 * Check if the Pointer not a Null one
 	 * To avoid segmentation fault
@@ -50,13 +380,34 @@ ISR(USART_TXC_vect){
 	 * Check if the Pointer not a Null one
 	 * To avoid segmentation fault
 	*/
-	if(g_callBackPtrUartRx != NULL_PTR){
+	if(g_callBackPtrUartTx != NULL_PTR){
 
 		 /* Call the Call Back function for UART Tx Interrupt */
 		(*g_callBackPtrUartTx)();
 	}
 }
 
+ISR(USART_UDRE_vect){
+
+	/* Tx block is sent first as bytes are queued behind it */
+	if(g_txBlockPtr != NULL_PTR){
+
+		UART_txBlockStep();
+	}
+
+	/* Check if there is something to be sent (To avoid sending garbage) */
+	else if(g_txHead != g_txTail){
+
+		/* Send next queued byte */
+		UART_txDrainStep();
+	}
+	else{
+
+		/* Nothing to be sent, disable UDRE Interrupt */
+		CLEAR_BIT(UCSRB,UDRIE);
+	}
+}
+
 
 /*******************************************************************************
  *                      Functions Definitions                                  *
@@ -66,12 +417,15 @@ ISR(USART_TXC_vect){
  [Function Name]:	UART_init
 
  [Description]:		Used to initialize UART Module
- 	 	 	 	 	- Choose BaudRate prefered
+ 	 	 	 	 	- BaudRate is chosen at compile time @UART_BAUD_RATE
  	 	 	 	 	- Decide Stop bits number
  	 	 	 	 	- Decide operating mode (Tx Interrupt, Rx Interrupt, both, or polling mode)
  	 	 	 	 	- Decide Parity  mode	(Even, Odd, or no parity)
+ 	 	 	 	 	- Decide Rx mode (Directly from UDR or through Rx ring buffer)
+ 	 	 	 	 	- Decide Tx mode (Busy wait on UDRE or through Tx ring buffer)
+ 	 	 	 	 	- Decide Multi-processor mode (Disabled, Master, or Slave with its address)
  	 	 	 	 	- Enable Tx, Rx both
-					- 8 bit Data transfer mode
+					- 8 bit Data transfer mode (9 bit in Multi-processor mode)
 					- Asynchronous Mode (UART not USART)
 
  [Args]:			config_Ptr
@@ -93,8 +447,8 @@ void UART_init(const UART_ConfigType* config_Ptr)
 	UBRRH &= 0x00;
 	UBRRL &= 0x00;
 
-	/* U2X = 1 for double transmission speed */
-	UCSRA = (1 << U2X);
+	/* U2X = 1 for double transmission speed only if it is needed to reach UART_BAUD_RATE */
+	UCSRA = (UART_USE_2X << U2X);
 
 	/* Enable UART Tx, Rx  */
 	UCSRB = (1 << RXEN) | (1 << TXEN);
@@ -102,6 +456,33 @@ void UART_init(const UART_ConfigType* config_Ptr)
 	/* Chose Operating Mode (Tx Interrupt, Rx Interrupt, both, or None) */
 	UCSRB = ( (UCSRB & 0x3F) | ( (config_Ptr -> InterruptMode) << TXCIE) );
 
+	/* Save Rx buffer mode and empty the ring buffer */
+	g_rxBufferMode	= config_Ptr -> RxBufferMode;
+	g_rxHead		= 0;
+	g_rxTail		= 0;
+
+	/* Rx ring buffer is filled from Rx ISR so Rx Interrupt must be enabled */
+	if(g_rxBufferMode == RX_BUFFER_ENABLE){
+
+		SET_BIT(UCSRB,RXCIE);
+	}
+
+	/*
+	 * Save Tx buffer mode and empty the ring buffer
+	 * UDRE Interrupt is enabled only when there are queued bytes
+	*/
+	g_txBufferMode	= config_Ptr -> TxBufferMode;
+	g_txHead		= 0;
+	g_txTail		= 0;
+	g_txWritten		= FALSE;
+
+	/* Start counting from zero */
+	UART_resetStatistics();
+
+	/* No block transfers running */
+	g_txBlockPtr	= NULL_PTR;
+	g_rxBlockPtr	= NULL_PTR;
+
 	/*
 	 * Enable UCSRC Register
 	 * Choose Asyncronous Mode
@@ -114,12 +495,34 @@ void UART_init(const UART_ConfigType* config_Ptr)
 	/* Choose Stop bits number (1 bit or 2 bits) */
 	UCSRC = ( (UCSRC & 0xF7) | ( (config_Ptr -> StopBit) << USBS) );
 
-	/* Choose 8 bit mode */
-	UCSRC = ( (UCSRC & 0xF9) | (EIGHT_BIT_CHAR_SIZE << UCSZ0) );
+	/* Save Multi-processor mode and own address of the slave */
+	g_mpcmMode		= config_Ptr -> MultiProcessorMode;
+	g_mpcmAddress	= config_Ptr -> Address;
 
-	/* First 8 bits from the BAUD_PRESCALE inside UBRRL and last 4 bits in UBRRH*/
-	UBRRH = ( ( ( (F_CPU / ( (config_Ptr -> BaudRate)* 8UL) ) ) - 1) >> 8 );
-	UBRRL = ( ( (F_CPU / ( (config_Ptr -> BaudRate)* 8UL) ) ) - 1);
+	/* Choose 8 bit mode, or 9 bit mode (UCSZ2 = 1) in Multi-processor mode */
+	if(g_mpcmMode == MPCM_DISABLE){
+
+		UCSRC = ( (UCSRC & 0xF9) | (EIGHT_BIT_CHAR_SIZE << UCSZ0) );
+	}
+	else{
+
+		UCSRC = ( (UCSRC & 0xF9) | ( (NINE_BIT_CHAR_SIZE & 0x03) << UCSZ0 ) );
+		SET_BIT(UCSRB,UCSZ2);
+	}
+
+	/* Slave ignores all data frames till it is addressed */
+	if(g_mpcmMode == MPCM_SLAVE){
+
+		/* Write U2X and MPCM only (Writing one to TXC flag clears it) */
+		UCSRA = (UCSRA & ((1 << U2X) | (1 << MPCM))) | (1 << MPCM);
+	}
+
+	/*
+	 * First 8 bits from the BAUD_PRESCALE inside UBRRL and last 4 bits in UBRRH
+	 * Value is calculated at compile time @UART_UBRR_VALUE
+	*/
+	UBRRH = (uint8)(UART_UBRR_VALUE >> 8);
+	UBRRL = (uint8)(UART_UBRR_VALUE);
 }
 
 
@@ -168,10 +571,35 @@ void UART_setCallBackRx(void (*f_ptr)(void)){
 
 
 
+/********************************************************************************
+ [Function Name]:	UART_setCallBackTxDrain
+
+ [Description]:		Function Callback called from Data Register Empty ISR when
+ 	 	 	 	 	the last queued byte is moved to UDR (Tx ring buffer is empty)
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to void function
+					which will save address of Drain Handler Function in main
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_setCallBackTxDrain(void (*f_ptr)(void)){
+	g_callBackPtrUartTxDrain = f_ptr;
+}
+
+
+
 /********************************************************************************
  [Function Name]:	UART_sendByte
 
  [Description]:		Function used to send byte through UART communication protocol
+ 	 	 	 	 	(Called while Global Interrupts are disabled, the Tx block
+ 	 	 	 	 	is sent by hand before it instead of waiting for UDRE ISR)
 
  [Args]:			data
 
@@ -185,21 +613,295 @@ void UART_setCallBackRx(void (*f_ptr)(void)){
 **********************************************************************************/
 void UART_sendByte(const uint8 data)
 {
+	/* A byte will be written to UDR, so UART_flush should wait for it */
+	g_txWritten = TRUE;
+
+	/* Check if Tx ring buffer mode is activated */
+	if(g_txBufferMode == TX_BUFFER_ENABLE){
+
+		/* Wait until UDRE ISR frees a place on the buffer */
+		while( (uint8)(g_txHead - g_txTail) >= UART_TX_BUFFER_SIZE ){
+
+			/*
+			 * Global Interrupts are disabled (called from ISR for example)
+			 * so drain the buffer manually to avoid dead lock
+			*/
+			UART_txPollStep();
+		}
+
+		/* Queue the byte and move the head */
+		g_txBuffer[g_txHead & UART_TX_BUFFER_MASK] = data;
+		g_txHead++;
+
+		/* Enable UDRE Interrupt to drain the buffer */
+		SET_BIT(UCSRB,UDRIE);
+
+		return;
+	}
+
+	/* Wait until UDRE ISR sends the Tx block (To keep bytes order) */
+	while(g_txBlockPtr != NULL_PTR){
+
+		/* Global Interrupts are disabled so send the block manually */
+		UART_txPollStep();
+	}
+
 	/* UDRE flag is set when the Tx buffer (UDR) is empty and ready for
 	 * transmitting a new byte so wait until this flag is set to one */
 	while(BIT_IS_CLEAR(UCSRA,UDRE)){}
 	/* Put the required data in the UDR register and it also clear the UDRE flag as
 	 * the UDR register is not empty now */
 	UDR = data;
+	g_statistics.BytesSent++;
+	/*
+	 * Clear TXC flag (by writing one) to be able to know when the shift out ends
+	 * Only U2X and MPCM are written back (FE, DOR and PE are read only)
+	*/
+	UCSRA = (UCSRA & ((1 << U2X) | (1 << MPCM))) | (1 << TXC);
 	/************************* Another Method *************************
 	UDR = data;
 	while(BIT_IS_CLEAR(UCSRA,TXC)){} // Wait until the transimission is complete TXC = 1
-	SET_BIT(UCSRA,TXC); // Clear the TXC flag
+	UCSRA = (UCSRA & ((1 << U2X) | (1 << MPCM))) | (1 << TXC); // Clear the TXC flag
 	*******************************************************************/
 }
 
 
 
+/********************************************************************************
+ [Function Name]:	UART_sendAddress
+
+ [Description]:		Function used to send an address frame (9th bit is 1) in
+ 	 	 	 	 	MPCM_MASTER mode to select the slave of the next data bytes
+ 	 	 	 	 	- Waits until all queued bytes are sent first
+ 	 	 	 	 	- UART_MPCM_BROADCAST_ADDRESS selects all slaves
+
+ [Args]:			address
+
+ [in]				address: Address of the slave
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_sendAddress(uint8 address)
+{
+	/* Queued data bytes must be sent with 9th bit = 0 before the address */
+	while( (g_txHead != g_txTail) || (g_txBlockPtr != NULL_PTR) ){
+
+		/* Global Interrupts are disabled so send the block and drain the buffer manually */
+		UART_txPollStep();
+	}
+
+	/* A byte will be written to UDR, so UART_flush should wait for it */
+	g_txWritten = TRUE;
+
+	while(BIT_IS_CLEAR(UCSRA,UDRE)){}
+
+	/* 9th bit MUST be written before UDR */
+	SET_BIT(UCSRB,TXB8);
+	UDR = address;
+	g_statistics.BytesSent++;
+
+	/*
+	 * Clear TXC flag (by writing one) to be able to know when the shift out ends
+	 * Only U2X and MPCM are written back (FE, DOR and PE are read only)
+	*/
+	UCSRA = (UCSRA & ((1 << U2X) | (1 << MPCM))) | (1 << TXC);
+
+	/* TXB8 is taken when the address moves to the shift register (UDRE = 1 again) */
+	while(BIT_IS_CLEAR(UCSRA,UDRE)){}
+	CLEAR_BIT(UCSRB,TXB8);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_sendBuffer
+
+ [Description]:		Function used to send number of bytes as one operation
+ 	 	 	 	 	- Bytes are moved to UDR directly from the caller buffer by
+ 	 	 	 	 	  Data Register Empty ISR (No copy and no busy wait)
+ 	 	 	 	 	- Buffer must NOT be changed till the callback is called
+ 	 	 	 	 	- Bytes sent by UART_sendByte after it are sent after the block
+ 	 	 	 	 	(Global Interrupts must be enabled)
+
+ [Args]:			buffer, length, f_ptr
+
+ [in]				buffer: Pointer to the bytes to be sent
+ 	 	 	 	 	length: Number of bytes to be sent
+ 	 	 	 	 	f_ptr:	Pointer to void function called from ISR when the last
+ 	 	 	 	 	 	 	byte is moved to UDR (NULL_PTR if not needed)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			UART_OK if the transfer started, UART_BUSY if a previous
+ 	 	 	 	 	block or queued bytes are still being sent
+**********************************************************************************/
+UART_StatusType UART_sendBuffer(const uint8 *buffer, uint8 length, void (*f_ptr)(void))
+{
+	/* Previous block or queued bytes must be sent first (To keep bytes order) */
+	if( (g_txBlockPtr != NULL_PTR) || (g_txHead != g_txTail) ){
+
+		return UART_BUSY;
+	}
+
+	/* Nothing to be sent */
+	if(length == 0){
+
+		if(f_ptr != NULL_PTR){
+
+			(*f_ptr)();
+		}
+
+		return UART_OK;
+	}
+
+	/* A byte will be written to UDR, so UART_flush should wait for it */
+	g_txWritten = TRUE;
+
+	g_callBackPtrUartTxBlock	= f_ptr;
+	g_txBlockLength				= length;
+	g_txBlockIndex				= 0;
+
+	/* Pointer is written last as UDRE ISR checks it */
+	g_txBlockPtr = buffer;
+
+	/* UDRE ISR moves the block to UDR byte by byte */
+	SET_BIT(UCSRB,UDRIE);
+
+	return UART_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_receiveBuffer
+
+ [Description]:		Function used to receive number of bytes as one operation
+ 	 	 	 	 	- Bytes already waiting in Rx ring buffer are taken first
+ 	 	 	 	 	- Rest of bytes are saved by Rx ISR directly in the caller buffer
+ 	 	 	 	 	- Buffer must NOT be used till the callback is called
+ 	 	 	 	 	(Global Interrupts must be enabled)
+
+ [Args]:			buffer, length, f_ptr
+
+ [in]				length: Number of bytes to be received
+ 	 	 	 	 	f_ptr:	Pointer to void function called when the last byte
+ 	 	 	 	 	 	 	is received (NULL_PTR if not needed)
+
+ [out]				buffer: Pointer to an array to save the received bytes on it
+
+ [in/out]			None
+
+ [Returns]:			UART_OK if the transfer started, UART_BUSY if a previous
+ 	 	 	 	 	block is still being received
+**********************************************************************************/
+UART_StatusType UART_receiveBuffer(uint8 *buffer, uint8 length, void (*f_ptr)(void))
+{
+	/* Save Global Interrupt state to restore it */
+	uint8 sreg;
+
+	/* Byte taken from Rx ring buffer */
+	uint8 data;
+
+	/* Previous block is not completed yet */
+	if(g_rxBlockPtr != NULL_PTR){
+
+		return UART_BUSY;
+	}
+
+	/* Nothing to be received */
+	if(length == 0){
+
+		if(f_ptr != NULL_PTR){
+
+			(*f_ptr)();
+		}
+
+		return UART_OK;
+	}
+
+	sreg = SREG;
+
+	/* Rx ISR must not save bytes in the ring buffer while the block is started */
+	cli();
+
+	g_callBackPtrUartRxBlock	= f_ptr;
+	g_rxBlockLength				= length;
+	g_rxBlockIndex				= 0;
+	g_rxBlockPtr				= buffer;
+
+	/* Remember if Rx Interrupt was enabled before to restore it when the block ends */
+	g_rxBlockIntEnabled = ( BIT_IS_SET(UCSRB,RXCIE) ? TRUE : FALSE );
+
+	/* Bytes received before the call are older, so they are the first block bytes */
+	while( (g_rxBlockPtr != NULL_PTR) && (g_rxBufferMode == RX_BUFFER_ENABLE) && (g_rxHead != g_rxTail) ){
+
+		data = g_rxBuffer[g_rxTail & UART_RX_BUFFER_MASK];
+		g_rxTail++;
+
+		UART_rxBlockStep(data);
+	}
+
+	/* Rest of the block is received by Rx ISR */
+	if(g_rxBlockPtr != NULL_PTR){
+
+		SET_BIT(UCSRB,RXCIE);
+	}
+
+	SREG = sreg;
+
+	return UART_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_flush
+
+ [Description]:		Function used to wait until all queued bytes are drained
+ 	 	 	 	 	and the last byte is completely shifted out of Tx pin
+ 	 	 	 	 	(Called while Global Interrupts are disabled, the Tx block
+ 	 	 	 	 	and queued bytes are sent by hand instead of waiting for
+ 	 	 	 	 	UDRE ISR)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_flush(void)
+{
+	/* Nothing sent from last flush, so TXC flag will never be set */
+	if(g_txWritten == FALSE){
+
+		return;
+	}
+
+	/* Wait until UDRE ISR sends the Tx block and all queued bytes */
+	while( (g_txHead != g_txTail) || BIT_IS_SET(UCSRB,UDRIE) ){
+
+		/* Global Interrupts are disabled so send the block and drain the buffer manually */
+		UART_txPollStep();
+	}
+
+	/* Wait until the last byte is shifted out (TXC = 1) */
+	while(BIT_IS_CLEAR(UCSRA,TXC)){}
+
+	g_txWritten = FALSE;
+}
+
+
+
 /********************************************************************************
  [Function Name]:	UART_recieveByte
 
@@ -217,12 +919,257 @@ void UART_sendByte(const uint8 data)
 **********************************************************************************/
 uint8 UART_recieveByte(void)
 {
+	/* Byte read from Rx ring buffer */
+	uint8 data;
+
+	/* Check if Rx ring buffer mode is activated */
+	if(g_rxBufferMode == RX_BUFFER_ENABLE){
+
+		/*
+		 * Wait until Rx ISR puts a byte on the buffer
+		 * bytes received meanwhile are never lost till the buffer is full
+		*/
+		while(UART_read(&data) == FALSE){}
+
+		return data;
+	}
+
 	/* RXC flag is set when the UART receive data so wait until this
-	 * flag is set to one */
-	while(BIT_IS_CLEAR(UCSRA,RXC)){}
+	 * flag is set to one (Address frames are skipped in MPCM_SLAVE mode) */
+	do{
+		while(BIT_IS_CLEAR(UCSRA,RXC)){}
+	}while(UART_checkAddressFrame() == TRUE);
 	/* Read the received data from the Rx buffer (UDR) and the RXC flag
 	   will be cleared after read this data */
-    return UDR;
+    return UART_readData();
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_recieveByteTimeout
+
+ [Description]:		Function used to receive a byte through UART Communication Protocol
+ 	 	 	 	 	but waiting for a bounded time only
+ 	 	 	 	 	(UART_timeoutTick must be called periodically from a timer ISR)
+
+ [Args]:			data, timeout
+
+ [in]				timeout: Maximum time to wait in milli seconds
+
+ [out]				data: Pointer to unsigned char to save the received byte on it
+
+ [in/out]			None
+
+ [Returns]:			UART_OK if a byte is received, UART_TIMEOUT otherwise
+**********************************************************************************/
+UART_StatusType UART_recieveByteTimeout(uint8 *data, uint16 timeout)
+{
+	/* Check first without starting the timer (Byte may be received already) */
+	if(UART_read(data) == TRUE){
+
+		return UART_OK;
+	}
+
+	UART_startTimeout(timeout);
+
+	/* Wait until a byte is received or time is out */
+	while(UART_read(data) == FALSE){
+
+		if(g_timeoutExpired == TRUE){
+
+			return UART_TIMEOUT;
+		}
+	}
+
+	return UART_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_receiveBufferTimeout
+
+ [Description]:		Function used to receive number of bytes through UART
+ 	 	 	 	 	within a bounded time for the whole buffer
+ 	 	 	 	 	(UART_timeoutTick must be called periodically from a timer ISR)
+
+ [Args]:			buffer, length, timeout
+
+ [in]				length:	 Number of bytes to be received
+ 	 	 	 	 	timeout: Maximum time to wait for all bytes in milli seconds
+
+ [out]				buffer: Pointer to an array to save the received bytes on it
+
+ [in/out]			None
+
+ [Returns]:			UART_OK if all bytes are received, UART_TIMEOUT otherwise
+**********************************************************************************/
+UART_StatusType UART_receiveBufferTimeout(uint8 *buffer, uint8 length, uint16 timeout)
+{
+	/* Number of received bytes */
+	uint8 i = 0;
+
+	/* One timeout for the whole buffer */
+	UART_startTimeout(timeout);
+
+	while(i < length){
+
+		if(UART_read(&buffer[i]) == TRUE){
+
+			i++;
+		}
+		else if(g_timeoutExpired == TRUE){
+
+			return UART_TIMEOUT;
+		}
+	}
+
+	return UART_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_timeoutTick
+
+ [Description]:		Time base of UART timeouts, it should be given as a callback
+ 	 	 	 	 	to a timer which interrupts every UART_TIMEOUT_TICK_MS
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_timeoutTick(void)
+{
+	/* Count down the running timeout if any */
+	if(g_timeoutTicks > 0){
+
+		g_timeoutTicks--;
+
+		if(g_timeoutTicks == 0){
+
+			g_timeoutExpired = TRUE;
+		}
+	}
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_available
+
+ [Description]:		Function used to know how many bytes are waiting in the
+ 	 	 	 	 	Rx ring buffer (RX_BUFFER_ENABLE mode)
+ 	 	 	 	 	In RX_BUFFER_DISABLE mode it returns 1 if RXC flag is set
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Number of received bytes ready to be read
+**********************************************************************************/
+uint8 UART_available(void)
+{
+	/* Polling mode so check for RXC flag */
+	if(g_rxBufferMode == RX_BUFFER_DISABLE){
+
+		return (BIT_IS_SET(UCSRA,RXC) ? 1U : 0U);
+	}
+
+	/* Free running indices so subtraction gives the number of bytes */
+	return (uint8)(g_rxHead - g_rxTail);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_peek
+
+ [Description]:		Function used to get the oldest received byte without
+ 	 	 	 	 	removing it from the Rx ring buffer (Non blocking)
+ 	 	 	 	 	Only works in RX_BUFFER_ENABLE mode as reading UDR clears it
+
+ [Args]:			data
+
+ [in]				None
+
+ [out]				data: Pointer to unsigned char to save the byte on it
+
+ [in/out]			None
+
+ [Returns]:			TRUE if a byte is available, FALSE if buffer is empty
+**********************************************************************************/
+uint8 UART_peek(uint8 *data)
+{
+	/*
+	 * Nothing received yet or Polling mode
+	 * (Byte can NOT be peeked from UDR without clearing it)
+	*/
+	if( (g_rxBufferMode == RX_BUFFER_DISABLE) || (UART_available() == 0) ){
+
+		return FALSE;
+	}
+
+	*data = g_rxBuffer[g_rxTail & UART_RX_BUFFER_MASK];
+
+	return TRUE;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_read
+
+ [Description]:		Function used to get the oldest received byte and remove it
+ 	 	 	 	 	from the Rx ring buffer (Non blocking)
+
+ [Args]:			data
+
+ [in]				None
+
+ [out]				data: Pointer to unsigned char to save the byte on it
+
+ [in/out]			None
+
+ [Returns]:			TRUE if a byte is read, FALSE if buffer is empty
+**********************************************************************************/
+uint8 UART_read(uint8 *data)
+{
+	/* Nothing received yet */
+	if(UART_available() == 0){
+
+		return FALSE;
+	}
+
+	/* Polling mode so read the byte directly from UDR register */
+	if(g_rxBufferMode == RX_BUFFER_DISABLE){
+
+		/* Address frame is not a byte for the application */
+		if(UART_checkAddressFrame() == TRUE){
+
+			return FALSE;
+		}
+
+		*data = UART_readData();
+		return TRUE;
+	}
+
+	/* Read the byte then move the tail to free its place for Rx ISR */
+	*data = g_rxBuffer[g_rxTail & UART_RX_BUFFER_MASK];
+	g_rxTail++;
+
+	return TRUE;
 }
 
 
@@ -293,3 +1240,103 @@ void UART_receiveString(uint8 *Str)
 	}
 	Str[i] = '\0';
 }
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_getStatistics
+
+ [Description]:		Function used to take a copy of the link statistics
+ 	 	 	 	 	(Copied with Global Interrupts disabled to be consistent)
+
+ [Args]:			statistics_Ptr
+
+ [in]				None
+
+ [out]				statistics_Ptr: Pointer to structure to save the statistics on it
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_getStatistics(UART_StatisticsType *statistics_Ptr)
+{
+	/* Save Global Interrupt state to restore it */
+	uint8 sreg = SREG;
+
+	cli();
+
+	*statistics_Ptr = *(const UART_StatisticsType*)&g_statistics;
+
+	SREG = sreg;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_resetStatistics
+
+ [Description]:		Function used to clear all the link statistics counters
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_resetStatistics(void)
+{
+	/* Save Global Interrupt state to restore it */
+	uint8 sreg = SREG;
+
+	cli();
+
+	g_statistics.BytesSent		= 0;
+	g_statistics.BytesReceived	= 0;
+	g_statistics.OverrunErrors	= 0;
+	g_statistics.FramingErrors	= 0;
+	g_statistics.ParityErrors	= 0;
+	g_statistics.DroppedBytes	= 0;
+	g_statistics.MaxRxOccupancy	= 0;
+
+	SREG = sreg;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_dumpStatistics
+
+ [Description]:		Function used to give every statistics counter with its name
+ 	 	 	 	 	to a print function (LCD, another UART, debugger, ...)
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to function which prints one counter
+ 	 	 	 	 	 	   (Name string and its value)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_dumpStatistics(void (*f_ptr)(const uint8 *name, uint32 value))
+{
+	/* Copy of the statistics (Counters may change while printing) */
+	UART_StatisticsType statistics;
+
+	UART_getStatistics(&statistics);
+
+	(*f_ptr)((const uint8*)"TX", statistics.BytesSent);
+	(*f_ptr)((const uint8*)"RX", statistics.BytesReceived);
+	(*f_ptr)((const uint8*)"DOR", statistics.OverrunErrors);
+	(*f_ptr)((const uint8*)"FE", statistics.FramingErrors);
+	(*f_ptr)((const uint8*)"PE", statistics.ParityErrors);
+	(*f_ptr)((const uint8*)"DROP", statistics.DroppedBytes);
+	(*f_ptr)((const uint8*)"RXMAX", statistics.MaxRxOccupancy);
+}
@@ -5,25 +5,31 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../LCD.c \
+../crc.c \
 ../i2c.c \
 ../keypad.c \
 ../main.c \
+../protocol.c \
 ../timers.c \
 ../uart.c 
 
 OBJS += \
 ./LCD.o \
+./crc.o \
 ./i2c.o \
 ./keypad.o \
 ./main.o \
+./protocol.o \
 ./timers.o \
 ./uart.o 
 
 C_DEPS += \
 ./LCD.d \
+./crc.d \
 ./i2c.d \
 ./keypad.d \
 ./main.d \
+./protocol.d \
 ./timers.d \
 ./uart.d 
 
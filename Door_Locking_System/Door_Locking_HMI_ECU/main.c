@@ -13,23 +13,7 @@
 #include "uart.h"
 #include "LCD.h"
 #include "keypad.h"
-
-/***********************************************************************
- 	 	 	 	 	 	 	 Preprocessor Macros
- ***********************************************************************/
-#define M1_READY 							0x10
-#define NO_PREVIOS_PASSWORDS 				0x20
-#define NEW_PASSWORD_TO_BE_SAVED			0x21
-#define NEW_PASSWORD_SAVED_SUCCESSFULLY		0x22
-#define PREVIOUS_PASSWORD_DETECTED			0x23
-#define OVER_WRITE_OLD_PASSWORD				0x30
-#define STEP3_DOOR_MANIPULATION				0x40
-#define CHECK_PASSWORD						0x41
-#define CORRECT_PASSWORD					0x42
-#define INCORRECT_PASSWORD					0x43
-#define PASSWORD_WRONG_3_TIMES				0x44
-#define DOOR_OPEN							0x45
-#define DOOR_CLOSE							0x46
+#include "protocol.h"
 
 /************************************************************************
   	  	  	  	  	  	  	  Function Prototypes
@@ -40,7 +24,7 @@ void Step2_mainCode(void);
 void Step3_doorManipulation(void);
 uint8 Enter_password(uint8* arr1, uint8* arr2);
 void New_passwordCorrectCode(uint8* arr);
-void Password_check(void);
+uint8 Password_check(void);
 void Theif_onTheSystem(void);
 void Door_off(void);
 void Door_on(void);
@@ -58,9 +42,6 @@ volatile uint8 g_timer1_1MinFlag = 0;
 /* Flag to find the theif */
 uint8 g_theifFlag = 0;
 
-/* Flag to step 2 finishing the code */
-uint8 g_step2FinishFlag = 0;
-
 /* Flag to step 1 finishing the code */
 uint8 g_step1FinishFlag = 0;
 
@@ -70,9 +51,15 @@ uint8 g_step1FinishFlag = 0;
  ***********************************************************************/
 int main(void){
 
+	/* Response frame of Control ECU */
+	Protocol_FrameType reply;
+
 	/* Timer Structure for timer 1 configurations */
 	Timer_ConfigType timer1_Strut;
 
+	/* Timer Structure for timer 0 configurations */
+	Timer_ConfigType timer0_Strut;
+
 	/* UART Structure for its configurations */
 	UART_ConfigType uart_Struct;
 
@@ -85,10 +72,22 @@ int main(void){
 	timer1_Strut.InitialValue		= 0;
 	timer1_Strut.CompareValue		= 7900;
 
-	uart_Struct.BaudRate			= 9600;
+	/* Timer0 Tick every 1 milli Second (8MHz / 64 / 125) for UART timeouts */
+	timer0_Strut.TimerID 			= TIMER_ID_0;
+	timer0_Strut.TimerMode			= CTC_MODE;
+	timer0_Strut.CompareMatchMode	= NORMAL;
+	timer0_Strut.OutputPin			= NONE;
+	timer0_Strut.Prescaler			= FCPU_OVER_64;
+	timer0_Strut.InitialValue		= 0;
+	timer0_Strut.CompareValue		= 124;
+
 	uart_Struct.InterruptMode		= POLLING;
 	uart_Struct.ParityMode			= NO_PARIT_BITS;
 	uart_Struct.StopBit				= STOP_BIT_1_BIT;
+	uart_Struct.RxBufferMode		= RX_BUFFER_ENABLE;
+	uart_Struct.TxBufferMode		= TX_BUFFER_ENABLE;
+	uart_Struct.MultiProcessorMode	= MPCM_MASTER;
+	uart_Struct.Address				= 0;
 
 	/* LCD Initialization */
 	LCD_Init();
@@ -108,12 +107,17 @@ int main(void){
 	/* CallBack Function for timer 1 CTC Channel A Interrupt Function */
 	Timer1_setCallBack(Timer1_INT);
 
+	/* Timer 0 Initialization */
+	Timer_init(&timer0_Strut);
+
+	/* CallBack Function for timer 0 CTC Interrupt Function (Time base of UART timeouts) */
+	Timer0_setCallBack(UART_timeoutTick);
+
 	/* UART Initialization */
 	UART_init(&uart_Struct);
 
-
-	/* Send an ACK For other MC to start UART */
-	UART_sendByte(M1_READY) ;
+	/* Frames are sent to this door Control ECU on the shared bus */
+	Protocol_setDestination(PROTOCOL_CONTROL_ECU_ADDRESS);
 
 	/* Start from first Pixel */
 	LCD_goToRowColumn(0,0);
@@ -125,8 +129,15 @@ int main(void){
 
 	_delay_ms(500);
 
+	/*
+	 * Tell Control ECU that HMI ECU started and
+	 * ask it if there are previos password saved or not
+	 * (Keep asking till Control ECU answers, it may start after HMI ECU)
+	 */
+	while(Protocol_request(M1_READY, NULL_PTR, 0, &reply) != PROTOCOL_FRAME_READY){}
+
 	/* Check if there are no previos password saved */
-		if(UART_recieveByte() == NO_PREVIOS_PASSWORDS)
+		if(reply.Type == NO_PREVIOS_PASSWORDS)
 		{
 			/*
 			 * Go to Step 1 of Application code
@@ -145,7 +156,7 @@ int main(void){
 		}
 
 		/* There is a previos password saved */
-		else if(UART_recieveByte() == PREVIOUS_PASSWORD_DETECTED){
+		else if(reply.Type == PREVIOUS_PASSWORD_DETECTED){
 			LCD_displayString((uint8*)"Previous password");
 		}
 
@@ -185,15 +196,15 @@ int main(void){
  **********************************************************************************/
 void Step1_setPassword(void){
 
+	/* Response frame of Control ECU */
+	Protocol_FrameType reply;
+
 	/* Array to hold keypad pressed buttons */
 	uint8 keypadPassword[5] = {0};
 
 	/* Array to check if both passwords are correct or not */
 	uint8 keypadCheckPassword[5] = {0};
 
-	/* Counter Variable */
-	uint8 i = 0;
-
 	/* Counter flag for password checking */
 	uint8 flag = 0;
 
@@ -228,21 +239,11 @@ void Step1_setPassword(void){
 
 		_delay_ms(1000);
 
-		/* Send Ack to UART to start receiving the new password */
-		UART_sendByte(NEW_PASSWORD_TO_BE_SAVED);
-
-		/* Send Password to Control ECU by UART */
-		for(i = 0; i < 5; i++){
-
-			/* Send Password Byte by byte to Control ECU by UART*/
-			UART_sendByte(keypadPassword[i]);
-		}
-
-		/* Waiting for Control ECU to finish computation on passwords */
-		while(UART_recieveByte() != M1_READY );
+		/* Send Password to Control ECU in one frame and wait for its response */
+		Protocol_request(NEW_PASSWORD_TO_BE_SAVED, keypadPassword, PROTOCOL_PASSWORD_LENGTH, &reply);
 
 		/* Check if password saved successfully on eeprom or not */
-		if(UART_recieveByte() == NEW_PASSWORD_SAVED_SUCCESSFULLY){
+		if(reply.Type == NEW_PASSWORD_SAVED_SUCCESSFULLY){
 
 			/* Password Saved Successfully */
 			LCD_clearScreen();
@@ -321,24 +322,17 @@ _delay_ms(300);
 /* Check for '+' Sign which is change password */
 if(keyPressed == '+'){
 
-	UART_sendByte(M1_READY);
-
-	UART_sendByte(OVER_WRITE_OLD_PASSWORD);
-
 	LCD_clearScreen();
 
 	LCD_displayString((uint8*)"Change Password");
 
 	_delay_ms(1000);
 
-	/* Go to check password function */
-	 Password_check();
-
-	 /*
-	  * Check for theif flag
-	  * (if Password is wrong 3 times consecutively)
+	/*
+	 * Go to check password function
+	 * (False if Password is wrong 3 times consecutively or no response)
 	 */
-	 if(g_theifFlag == 0){
+	 if(Password_check() == TRUE){
 
 		LCD_clearScreen();
 
@@ -361,17 +355,6 @@ if(keyPressed == '+'){
 		if(flag == 5){
 			New_passwordCorrectCode(keypadPassword);
 
-			/*
-			 * Setting Step2FinishFlag to 1
-			 * This Flag to indicate that step 2 finished
-			 * if door manipulation executed after
-			 * change password function, i should send
-			 * M1_READY ACK 3 times due to system latency
-			 * so this flag is indication for me that i
-			 * finished Step 2 Function code
-			*/
-			g_step2FinishFlag = 1;
-
 		}
 		/* Both Passwords not matched */
 		else{
@@ -413,48 +396,20 @@ else if(keyPressed == '-'){
  **********************************************************************************/
 void Step3_doorManipulation(void){
 
+	/* Response frame of Control ECU */
+	Protocol_FrameType reply;
+
 	LCD_clearScreen();
 
 	LCD_displayString((uint8*)"Door Manipul");
 
 	_delay_ms(1000);
 
-	/* ACK for Control ECU */
-	UART_sendByte(M1_READY);
-
-	/* Second time sending due to system latency */
-	UART_sendByte(M1_READY);
-
-	/*  */
-	if(g_step2FinishFlag == 1){
-
-		/*
-		 * Clear Step2FinishFlag
-		 * This Flag to indicate that step 2 finished
-		 * if door manipulation executed after
-		 * change password function, i should send
-		 * M1_READY ACK 3 times due to system latency
-		 * so this flag is indication for me that i
-		 * finished Step 2 Function code and now i should
-		 * send the ACK for the 3rd time
-		*/
-		g_step2FinishFlag = 0;
-
-		/* Third time sending due to system latency */
-		UART_sendByte(M1_READY);
-
-	}
-	/* Telling them that we are in step 3 */
-	UART_sendByte(STEP3_DOOR_MANIPULATION);
-
-	/* Check for passowrd */
-	Password_check();
-
-	 /*
-	  * Check for theif flag
-	  * (if Password is wrong 3 times consecutively)
+	/*
+	 * Check for passowrd
+	 * (False if Password is wrong 3 times consecutively or no response)
 	 */
-	if(g_theifFlag == 0){
+	if(Password_check() == TRUE){
 
 	LCD_displayStringRowColumn(1,0,"Correct Pass");
 
@@ -464,7 +419,13 @@ void Step3_doorManipulation(void){
 
 	LCD_displayStringRowColumn(1,0,"Door Opening");
 
-	/* Correct Password Received */
+	/* Correct Password Received, ask Control ECU to open the door */
+	Protocol_request(DOOR_OPEN, NULL_PTR, 0, &reply);
+
+	/* Control ECU refused to open the door */
+	if(reply.Type != DOOR_OPEN){
+		return;
+	}
 
 	/* Open Door for 10 seconds */
 	Door_on();
@@ -586,9 +547,6 @@ void Door_on(void){
 	/* Getting the value of the Counter flag now */
 	save_globalNow = g_timer1_10SecFlag;
 
-	/* Send an ACK to the Control ECU to start opening the door */
-	UART_sendByte(DOOR_OPEN);
-
 	/*
 	 * delay for 10 Seconds to open the door
 	 * Here i check for the global counter flag value
@@ -633,9 +591,6 @@ void Door_off(void){
 	/* Getting the value of the Counter flag now */
 	save_globalNow = g_timer1_10SecFlag;
 
-	/* Send an ACK to the Control ECU to start Closing the door */
-	UART_sendByte(DOOR_CLOSE);
-
 	/*
 	 * delay for 10 Seconds to close the door
 	 * Here i check for the global counter flag value
@@ -666,66 +621,55 @@ void Door_off(void){
 
  [in/out]			None
 
- [Returns]:			None
+ [Returns]:			TRUE if password is correct, FALSE if it is wrong for
+ 	 	 	 	 	3 times or Control ECU did NOT respond
  **********************************************************************************/
-void Password_check(void){
+uint8 Password_check(void){
 
-	/* Variable to save the status of the operations */
-	uint8 status = 0;
+	/* Response frame of Control ECU */
+	Protocol_FrameType reply;
 
 	/* Iteration variable */
 	uint8 i = 0;
 
 	/* Array to hold the password */
-	uint8 PasswordArr[5] = {0};
+	uint8 PasswordArr[PROTOCOL_PASSWORD_LENGTH] = {0};
 
 	/*
-	 * Variable to hold how many times fucntion called itself
-	 * made static to hold its last value after recalling
-	 * Not a good behavior to make the function call itself due to
-	 * stack overflow problems, but here function call itself only twice
-	 * so it wont be a big problem
+	 * Control ECU counts the wrong passwords, so ask for
+	 * the password again till it is correct or wrong for 3 times
 	*/
-	static uint8 Flag_of_Calling = 0;
-
-	/* Enter old password to check */
-	LCD_clearScreen();
-
-	LCD_displayString((uint8*)"Enter Password:");
-
-	LCD_goToRowColumn(1,0);
+	do{
+		/* Enter old password to check */
+		LCD_clearScreen();
 
-	/* Asking to enter password */
-	for(i = 0; i < 5; i++){
+		LCD_displayString((uint8*)"Enter Password:");
 
-		/* Receive password digit by digit */
-		PasswordArr[i] = KeyPad_getPressedKey();
+		LCD_goToRowColumn(1,0);
 
-		/* Press time */
-		_delay_ms(300);
+		/* Asking to enter password */
+		for(i = 0; i < PROTOCOL_PASSWORD_LENGTH; i++){
 
-		/* Indicator for reciving the digit */
-		LCD_displayCharacter('*');
-	}
-
-	/* Send Ack to UART to start receiving the password to check it*/
-	UART_sendByte(CHECK_PASSWORD);
+			/* Receive password digit by digit */
+			PasswordArr[i] = KeyPad_getPressedKey();
 
-	/* Send Password to Control ECU by UART */
-	for(i = 0; i < 5; i++){
+			/* Press time */
+			_delay_ms(300);
 
-		/* Send Password Byte by byte to Control ECU by UART*/
-		UART_sendByte(PasswordArr[i]);
-	}
+			/* Indicator for reciving the digit */
+			LCD_displayCharacter('*');
+		}
 
-	/* Wait till Control ECU finishes calculations */
-	while(UART_recieveByte() != M1_READY);
+		/*
+		 * Send Password to Control ECU in one frame and wait for the result
+		 * Expected to be CORRECT_PASSWORD, INCORRECT_PASSWORD or PASSWORD_WRONG_3_TIMES
+		*/
+		Protocol_request(CHECK_PASSWORD, PasswordArr, PROTOCOL_PASSWORD_LENGTH, &reply);
 
-	/* Expected to be CORRECT_PASSWORD or INCORRECT_PASSWORD */
-	status = UART_recieveByte();
+	}while(reply.Type == INCORRECT_PASSWORD);
 
 	/* Password checked by Control ECU and it is correct */
-	if(status == CORRECT_PASSWORD){
+	if(reply.Type == CORRECT_PASSWORD){
 
 		/*
 		 * Clear g_theifFlag which is responsible of checking
@@ -741,64 +685,33 @@ void Password_check(void){
 
 		_delay_ms(500);
 
+		return TRUE;
 	}
 
-	/* Password checked by Control ECU and it is incorrect */
-	else if(status == INCORRECT_PASSWORD){
-		/*
-		 * Incorrect Password!!
-		 * You Still Have 2 times
-		 * of putting the password correctly
-		 */
-
-		/* Increament Calling counter */
-		Flag_of_Calling++;
-		/*
-		 * Incorrect Password!!
-		 * You Still Have 2 times
-		 * of putting the password correctly
-		 */
-		if(Flag_of_Calling <= 2){
-
-			/*
-			 * Not the best practice because if user put the password
-			 * wrong a lot of time, all this context switching
-			 * may goes into stackoverflow.
-			 * So, i should think about another way
-			 */
-			Password_check();
-		}
-
-		/*
-		 * You entered the password wrong 3 times consecutively
-		 * Alarm (Buzzer) will turn on for 1 minute
-		 */
-		else{
-
-			/* Clearing the recalling flag */
-			Flag_of_Calling = 0;
-
+	/*
+	 * You entered the password wrong 3 times consecutively
+	 * Alarm (Buzzer) will turn on for 1 minute
+	 */
+	else if(reply.Type == PASSWORD_WRONG_3_TIMES){
 
-			/* Waiting till Control ECU ACK Which means that it finished its computation */
-			while(UART_recieveByte() != M1_READY);
+		/* Set the theif flag to 1*/
+		g_theifFlag = 1;
 
-			/*
-			 * Get a response from Control ECU to check if it knows that
-			 * there is a theif on the system or not
-			*/
-			if(UART_recieveByte() == (PASSWORD_WRONG_3_TIMES)){
+		/* Theif Function */
+		Theif_onTheSystem();
+	}
 
-			/* Set the theif flag to 1*/
-			g_theifFlag = 1;
+	/* Control ECU did NOT respond */
+	else{
 
-			/* Theif Function */
-			Theif_onTheSystem();
+		LCD_clearScreen();
 
+		LCD_displayString((uint8*)"No Response!");
 
-			}
-		}
+		_delay_ms(1000);
 	}
 
+	return FALSE;
 }
 
 
@@ -871,7 +784,9 @@ void Theif_onTheSystem(void){
  **********************************************************************************/
 void New_passwordCorrectCode(uint8* arr){
 
-	uint8 i = 0;
+	/* Response frame of Control ECU */
+	Protocol_FrameType reply;
+
 	/* Clear the screen */
 	LCD_clearScreen();
 
@@ -879,21 +794,11 @@ void New_passwordCorrectCode(uint8* arr){
 
 	_delay_ms(1000);
 
-	/* Send Ack to UART to start receiving the new password */
-	UART_sendByte(NEW_PASSWORD_TO_BE_SAVED);
-
-	/* Send Password to Control ECU by UART */
-	for(i = 0; i < 5; i++){
-
-		/* Send Password Byte by byte to Control ECU by UART*/
-		UART_sendByte(arr[i]);
-	}
-
-	/* Waiting for Control ECU to finish computation on passwords */
-	while(UART_recieveByte() != M1_READY );
+	/* Send Password to Control ECU in one frame and wait for its response */
+	Protocol_request(NEW_PASSWORD_TO_BE_SAVED, arr, PROTOCOL_PASSWORD_LENGTH, &reply);
 
 	/* Check if password saved successfully on eeprom or not */
-	if(UART_recieveByte() == NEW_PASSWORD_SAVED_SUCCESSFULLY){
+	if(reply.Type == NEW_PASSWORD_SAVED_SUCCESSFULLY){
 
 		/* Password Saved Successfully */
 		LCD_clearScreen();
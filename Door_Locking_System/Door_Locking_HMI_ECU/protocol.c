@@ -0,0 +1,527 @@
+ /******************************************************************************
+ *
+ * Module: Protocol
+ *
+ * File Name: protocol.c
+ *
+ * Description: Source file for the framed communication protocol between
+ * 				HMI ECU and Control ECU (Shared between both ECUs)
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#include "protocol.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Parser used by Protocol_receiveFrame to decode the UART stream */
+static Protocol_ParserType g_rxParser;
+
+/* Sequence number of the last request sent by Protocol_request */
+static uint8 g_requestSequence = 0;
+
+/* Last request received by Protocol_receiveFrame and its saved response */
+static uint8 g_lastRequestType		= PROTOCOL_NO_RESPONSE;
+static uint8 g_lastRequestSequence	= 0;
+static uint8 g_responseSaved		= FALSE;
+static Protocol_FrameType g_lastResponse;
+
+/* Frame bytes sent by UART_sendBuffer from the ISR (Must not change till it is sent) */
+static uint8 g_txFrame[PROTOCOL_MAX_PAYLOAD + PROTOCOL_FRAME_OVERHEAD];
+
+/* Flag cleared by UART when the last byte of g_txFrame is moved to UDR */
+static volatile uint8 g_txFrameBusy = FALSE;
+
+/* Address of the Control ECU which receives the frames (Multi-processor bus) */
+static uint8 g_destination = PROTOCOL_NO_DESTINATION;
+
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Called from UDRE ISR when the whole frame is moved to UART */
+static void Protocol_txFrameDone(void){
+
+	g_txFrameBusy = FALSE;
+}
+
+
+/* Send the frame bytes with a given sequence number */
+static void Protocol_transmit(uint8 type, uint8 sequence, const uint8 *payload_Ptr, uint8 length){
+
+	/* Iteration variable */
+	uint8 i;
+
+	/* Number of frame bytes */
+	uint8 size = 0;
+
+	/* Running CRC of the frame */
+	uint8 crc = CRC8_INITIAL_VALUE;
+
+	/* Previous frame is still being sent from g_txFrame */
+	while(g_txFrameBusy == TRUE){}
+
+	/* Select the receiver on the bus before every frame (It may be deselected meanwhile) */
+	if(g_destination != PROTOCOL_NO_DESTINATION){
+
+		UART_sendAddress(g_destination);
+	}
+
+	g_txFrame[size++] = PROTOCOL_SYNC_BYTE;
+
+	g_txFrame[size++] = type;
+	crc = CRC8_update(crc, type);
+
+	g_txFrame[size++] = sequence;
+	crc = CRC8_update(crc, sequence);
+
+	g_txFrame[size++] = length;
+	crc = CRC8_update(crc, length);
+
+	for(i = 0; i < length; i++){
+
+		g_txFrame[size++] = payload_Ptr[i];
+		crc = CRC8_update(crc, payload_Ptr[i]);
+	}
+
+	g_txFrame[size++] = crc;
+
+	/* Whole frame is sent by UART ISR as one block (Wait if bytes are still queued) */
+	g_txFrameBusy = TRUE;
+
+	while(UART_sendBuffer(g_txFrame, size, Protocol_txFrameDone) == UART_BUSY){}
+}
+
+
+/*
+ * Answer a repeated request with its saved response (Response was lost)
+ * Returns TRUE if the frame is a new request, it is remembered as the last one
+*/
+static uint8 Protocol_newRequest(const Protocol_FrameType *frame_Ptr){
+
+	/* Response of this request is lost, send it again without executing it twice */
+	if( (g_responseSaved == TRUE) &&
+		(frame_Ptr -> Type == g_lastRequestType) &&
+		(frame_Ptr -> Sequence == g_lastRequestSequence) ){
+
+		Protocol_transmit(g_lastResponse.Type, g_lastResponse.Sequence,
+						  g_lastResponse.Payload, g_lastResponse.Length);
+		return FALSE;
+	}
+
+	/* New request */
+	g_lastRequestType		= frame_Ptr -> Type;
+	g_lastRequestSequence	= frame_Ptr -> Sequence;
+	g_responseSaved			= FALSE;
+
+	return TRUE;
+}
+
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	Protocol_initParser
+
+ [Description]:		Used to reset a frame parser to wait for a new frame
+
+ [Args]:			parser_Ptr
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			parser_Ptr: Pointer to the parser to be reset
+
+ [Returns]:			None
+**********************************************************************************/
+void Protocol_initParser(Protocol_ParserType *parser_Ptr){
+
+	parser_Ptr -> State	= PARSER_WAIT_SYNC;
+	parser_Ptr -> Index	= 0;
+	parser_Ptr -> Crc	= CRC8_INITIAL_VALUE;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_parseByte
+
+ [Description]:		Used to give one received byte to the streaming parser
+ 	 	 	 	 	- Bytes before SYNC byte are ignored
+ 	 	 	 	 	- Too long or corrupted frames are rejected directly and the
+ 	 	 	 	 	  parser waits for the next SYNC byte
+
+ [Args]:			parser_Ptr, data
+
+ [in]				data: Received byte
+
+ [out]				None
+
+ [in/out]			parser_Ptr: Pointer to the parser
+ 	 	 	 	 	(parser_Ptr -> Frame is valid when PROTOCOL_FRAME_READY returned)
+
+ [Returns]:			Status of the parser @Protocol_StatusType
+**********************************************************************************/
+Protocol_StatusType Protocol_parseByte(Protocol_ParserType *parser_Ptr, uint8 data){
+
+	/* Status of the frame after this byte */
+	Protocol_StatusType status = PROTOCOL_FRAME_INCOMPLETE;
+
+	switch(parser_Ptr -> State){
+
+	case PARSER_WAIT_SYNC:
+
+		/* Ignore any byte till the start of a frame */
+		if(data == PROTOCOL_SYNC_BYTE){
+
+			Protocol_initParser(parser_Ptr);
+			parser_Ptr -> State = PARSER_WAIT_TYPE;
+		}
+		break;
+
+	case PARSER_WAIT_TYPE:
+
+		parser_Ptr -> Frame.Type	= data;
+		parser_Ptr -> Crc			= CRC8_update(parser_Ptr -> Crc, data);
+		parser_Ptr -> State			= PARSER_WAIT_SEQUENCE;
+		break;
+
+	case PARSER_WAIT_SEQUENCE:
+
+		parser_Ptr -> Frame.Sequence	= data;
+		parser_Ptr -> Crc				= CRC8_update(parser_Ptr -> Crc, data);
+		parser_Ptr -> State				= PARSER_WAIT_LENGTH;
+		break;
+
+	case PARSER_WAIT_LENGTH:
+
+		/* Reject the frame directly if the length can NOT fit */
+		if(data > PROTOCOL_MAX_PAYLOAD){
+
+			parser_Ptr -> State = PARSER_WAIT_SYNC;
+			status = PROTOCOL_FRAME_LENGTH_ERROR;
+			break;
+		}
+
+		parser_Ptr -> Frame.Length	= data;
+		parser_Ptr -> Crc			= CRC8_update(parser_Ptr -> Crc, data);
+
+		/* Frame without payload (Command only) goes to CRC directly */
+		parser_Ptr -> State = ( (data == 0) ? PARSER_WAIT_CRC : PARSER_WAIT_PAYLOAD );
+		break;
+
+	case PARSER_WAIT_PAYLOAD:
+
+		parser_Ptr -> Frame.Payload[parser_Ptr -> Index] = data;
+		parser_Ptr -> Crc = CRC8_update(parser_Ptr -> Crc, data);
+		parser_Ptr -> Index++;
+
+		/* All payload bytes received */
+		if(parser_Ptr -> Index == parser_Ptr -> Frame.Length){
+
+			parser_Ptr -> State = PARSER_WAIT_CRC;
+		}
+		break;
+
+	case PARSER_WAIT_CRC:
+
+		/* Frame ended, wait for the next one whatever the result is */
+		parser_Ptr -> State = PARSER_WAIT_SYNC;
+
+		status = ( (data == parser_Ptr -> Crc) ? PROTOCOL_FRAME_READY : PROTOCOL_FRAME_CRC_ERROR );
+		break;
+
+	default:
+
+		Protocol_initParser(parser_Ptr);
+		break;
+	}
+
+	return status;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_sendFrame
+
+ [Description]:		Used to send one whole response frame through UART
+ 	 	 	 	 	- It has the SEQUENCE of the last received request
+ 	 	 	 	 	- It is saved to be sent again if the request is repeated
+
+ [Args]:			type, payload_Ptr, length
+
+ [in]				type:		 Frame type @Frame types
+ 	 	 	 	 	payload_Ptr: Pointer to payload bytes (NULL_PTR if length is 0)
+ 	 	 	 	 	length:		 Number of payload bytes (PROTOCOL_MAX_PAYLOAD max)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Protocol_sendFrame(uint8 type, const uint8 *payload_Ptr, uint8 length){
+
+	Protocol_sendResponse(g_lastRequestType, g_lastRequestSequence, type, payload_Ptr, length);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_sendResponse
+
+ [Description]:		Used to send one whole response frame of a given request
+ 	 	 	 	 	through UART (A request answered later, after other ones)
+ 	 	 	 	 	- It has the SEQUENCE of that request
+ 	 	 	 	 	- It is saved to be sent again if that request is repeated
+
+ [Args]:			requestType, requestSequence, type, payload_Ptr, length
+
+ [in]				requestType:	 Frame type of the answered request
+ 	 	 	 	 	requestSequence: Sequence of the answered request
+ 	 	 	 	 	type:			 Frame type @Frame types
+ 	 	 	 	 	payload_Ptr:	 Pointer to payload bytes (NULL_PTR if length is 0)
+ 	 	 	 	 	length:			 Number of payload bytes (PROTOCOL_MAX_PAYLOAD max)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Protocol_sendResponse(uint8 requestType, uint8 requestSequence, uint8 type, const uint8 *payload_Ptr, uint8 length){
+
+	/* Iteration variable */
+	uint8 i;
+
+	/* Receiver will reject frames longer than that */
+	if(length > PROTOCOL_MAX_PAYLOAD){
+
+		length = PROTOCOL_MAX_PAYLOAD;
+	}
+
+	/* Save the response to answer the same request again if it is repeated */
+	g_lastRequestType		= requestType;
+	g_lastRequestSequence	= requestSequence;
+
+	g_lastResponse.Type		= type;
+	g_lastResponse.Sequence	= requestSequence;
+	g_lastResponse.Length	= length;
+
+	for(i = 0; i < length; i++){
+
+		g_lastResponse.Payload[i] = payload_Ptr[i];
+	}
+
+	g_responseSaved = TRUE;
+
+	Protocol_transmit(type, requestSequence, payload_Ptr, length);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_receiveFrame
+
+ [Description]:		Used to wait until a new valid request frame is received
+ 	 	 	 	 	- Corrupted or stalled frames are discarded
+ 	 	 	 	 	- Repeated requests are answered with the saved response
+ 	 	 	 	 	  directly without returning them
+
+ [Args]:			frame_Ptr
+
+ [in]				None
+
+ [out]				frame_Ptr: Pointer to frame structure to save the frame on it
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Protocol_receiveFrame(Protocol_FrameType *frame_Ptr){
+
+	while(1){
+
+		/* Wait for the first byte of a frame forever */
+		Protocol_parseByte(&g_rxParser, UART_recieveByte());
+
+		/* Rest of the frame bytes should come without a big gap */
+		if( (Protocol_receiveFrameTimeout(frame_Ptr, PROTOCOL_BYTE_TIMEOUT_MS) == PROTOCOL_FRAME_READY) &&
+			(Protocol_newRequest(frame_Ptr) == TRUE) ){
+
+			return;
+		}
+	}
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_receiveRequestTimeout
+
+ [Description]:		Used to wait for a bounded time until a new valid request
+ 	 	 	 	 	frame is received (Same as Protocol_receiveFrame), so the
+ 	 	 	 	 	caller can do other work between the requests
+ 	 	 	 	 	- Repeated requests are answered with the saved response
+ 	 	 	 	 	  directly without returning them
+
+ [Args]:			frame_Ptr, timeout
+
+ [in]				timeout:   Maximum time to wait for every byte in milli seconds
+
+ [out]				frame_Ptr: Pointer to frame structure to save the frame on it
+
+ [in/out]			None
+
+ [Returns]:			PROTOCOL_FRAME_READY or PROTOCOL_TIMEOUT
+**********************************************************************************/
+Protocol_StatusType Protocol_receiveRequestTimeout(Protocol_FrameType *frame_Ptr, uint16 timeout){
+
+	while(Protocol_receiveFrameTimeout(frame_Ptr, timeout) == PROTOCOL_FRAME_READY){
+
+		if(Protocol_newRequest(frame_Ptr) == TRUE){
+
+			return PROTOCOL_FRAME_READY;
+		}
+	}
+
+	return PROTOCOL_TIMEOUT;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_receiveFrameTimeout
+
+ [Description]:		Used to wait for a bounded time until a valid frame is received
+ 	 	 	 	 	(Corrupted or stalled frames are discarded)
+
+ [Args]:			frame_Ptr, timeout
+
+ [in]				timeout:   Maximum time to wait for every byte in milli seconds
+
+ [out]				frame_Ptr: Pointer to frame structure to save the frame on it
+
+ [in/out]			None
+
+ [Returns]:			PROTOCOL_FRAME_READY or PROTOCOL_TIMEOUT
+**********************************************************************************/
+Protocol_StatusType Protocol_receiveFrameTimeout(Protocol_FrameType *frame_Ptr, uint16 timeout){
+
+	/* Received byte */
+	uint8 data;
+
+	/* Status of the parser */
+	Protocol_StatusType status = PROTOCOL_FRAME_INCOMPLETE;
+
+	while(status != PROTOCOL_FRAME_READY){
+
+		/* Too big gap between two bytes, drop the partial frame */
+		if(UART_recieveByteTimeout(&data, timeout) != UART_OK){
+
+			Protocol_initParser(&g_rxParser);
+			return PROTOCOL_TIMEOUT;
+		}
+
+		status = Protocol_parseByte(&g_rxParser, data);
+	}
+
+	*frame_Ptr = g_rxParser.Frame;
+
+	return PROTOCOL_FRAME_READY;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_request
+
+ [Description]:		Used to send a request frame and wait for its response frame
+ 	 	 	 	 	(One round trip per operation)
+ 	 	 	 	 	- Request is sent again if no response in PROTOCOL_RESPONSE_TIMEOUT_MS
+ 	 	 	 	 	  for PROTOCOL_MAX_RETRIES times
+ 	 	 	 	 	- Responses of old requests are ignored
+
+ [Args]:			type, payload_Ptr, length, reply_Ptr
+
+ [in]				type:		 Request frame type @Frame types
+ 	 	 	 	 	payload_Ptr: Pointer to payload bytes (NULL_PTR if length is 0)
+ 	 	 	 	 	length:		 Number of payload bytes
+
+ [out]				reply_Ptr:	 Pointer to frame structure to save the response on it
+ 	 	 	 	 	 	 	 (Type is PROTOCOL_NO_RESPONSE if there is no response)
+
+ [in/out]			None
+
+ [Returns]:			PROTOCOL_FRAME_READY or PROTOCOL_TIMEOUT
+**********************************************************************************/
+Protocol_StatusType Protocol_request(uint8 type, const uint8 *payload_Ptr, uint8 length, Protocol_FrameType *reply_Ptr){
+
+	/* Number of sending times */
+	uint8 trial;
+
+	/* Receiver will reject frames longer than that */
+	if(length > PROTOCOL_MAX_PAYLOAD){
+
+		length = PROTOCOL_MAX_PAYLOAD;
+	}
+
+	/* New request number (same number for all trials of this request) */
+	g_requestSequence++;
+
+	for(trial = 0; trial <= PROTOCOL_MAX_RETRIES; trial++){
+
+		Protocol_transmit(type, g_requestSequence, payload_Ptr, length);
+
+		/* Ignore late responses of old requests till the right one or timeout */
+		while(Protocol_receiveFrameTimeout(reply_Ptr, PROTOCOL_RESPONSE_TIMEOUT_MS) == PROTOCOL_FRAME_READY){
+
+			if(reply_Ptr -> Sequence == g_requestSequence){
+
+				return PROTOCOL_FRAME_READY;
+			}
+		}
+	}
+
+	/* Control ECU did NOT answer */
+	reply_Ptr -> Type	= PROTOCOL_NO_RESPONSE;
+	reply_Ptr -> Length	= 0;
+
+	return PROTOCOL_TIMEOUT;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Protocol_setDestination
+
+ [Description]:		Used by the master to choose which Control ECU receives the
+ 	 	 	 	 	next frames, an address frame is sent before every frame
+ 	 	 	 	 	(UART must be in MPCM_MASTER mode)
+
+ [Args]:			address
+
+ [in]				address: Address of the Control ECU on the bus
+ 	 	 	 	 	 	 	 (PROTOCOL_NO_DESTINATION for a point to point line)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Protocol_setDestination(uint8 address){
+
+	g_destination = address;
+}
@@ -34,6 +34,81 @@
 #define STOP_BIT_2_BITS			(1U)
 
 #define EIGHT_BIT_CHAR_SIZE 	(3U)
+#define NINE_BIT_CHAR_SIZE	 	(7U)
+
+/* Address accepted by all slaves in Multi-processor Communication mode */
+#define UART_MPCM_BROADCAST_ADDRESS		(0xFFU)
+
+/*
+ * Baud rate used by UART_init, it is selected at compile time so the
+ * UBRR value and U2X bit are calculated by the preprocessor (No run time division)
+ * Can be overridden from compiler options (-DUART_BAUD_RATE=38400UL for example)
+*/
+#ifndef UART_BAUD_RATE
+#define UART_BAUD_RATE			(250000UL)
+#endif
+
+/* Maximum accepted baud rate error in per mille (20 = 2%) */
+#define UART_BAUD_TOLERANCE		(20UL)
+
+/* UBRR value rounded to the nearest integer (divider is 16 in normal speed, 8 in double speed) */
+#define UART_UBRR_CALC(BAUD,DIV)		( ( ( (F_CPU) + ( ( (DIV) * (BAUD) ) / 2UL ) ) / ( (DIV) * (BAUD) ) ) - 1UL )
+
+/* Real baud rate generated from a UBRR value */
+#define UART_BAUD_ACTUAL(BAUD,DIV)		( (F_CPU) / ( (DIV) * ( UART_UBRR_CALC(BAUD,DIV) + 1UL ) ) )
+
+/* Absolute baud rate error in per mille */
+#define UART_BAUD_ERROR(BAUD,DIV)		( ( (UART_BAUD_ACTUAL(BAUD,DIV) > (BAUD)) ? \
+										  (UART_BAUD_ACTUAL(BAUD,DIV) - (BAUD)) : \
+										  ((BAUD) - UART_BAUD_ACTUAL(BAUD,DIV)) ) * 1000UL / (BAUD) )
+
+/* Check that the baud rate is reachable with this divider (UBRR from 0 to 4095) */
+#define UART_BAUD_VALID(BAUD,DIV)		( ( ( (F_CPU) + ( ( (DIV) * (BAUD) ) / 2UL ) ) >= ( (DIV) * (BAUD) ) ) && \
+										  ( UART_UBRR_CALC(BAUD,DIV) <= 4095UL ) && \
+										  ( UART_BAUD_ERROR(BAUD,DIV) <= UART_BAUD_TOLERANCE ) )
+
+/*
+ * Choose Normal speed first as its receiver is more tolerant to clock error
+ * then Double speed (U2X = 1), otherwise stop the build
+*/
+#if UART_BAUD_VALID(UART_BAUD_RATE,16UL)
+#define UART_USE_2X				(0U)
+#define UART_UBRR_VALUE			UART_UBRR_CALC(UART_BAUD_RATE,16UL)
+#elif UART_BAUD_VALID(UART_BAUD_RATE,8UL)
+#define UART_USE_2X				(1U)
+#define UART_UBRR_VALUE			UART_UBRR_CALC(UART_BAUD_RATE,8UL)
+#else
+#error "UART_BAUD_RATE can NOT be generated from F_CPU with error less than UART_BAUD_TOLERANCE"
+#endif
+
+/*
+ * Size of the Rx ring buffer used in RX_BUFFER_ENABLE mode
+ * It MUST be a power of 2 and not bigger than 128 as the
+ * head/tail indices are free running 8 bit counters
+*/
+#define UART_RX_BUFFER_SIZE		(64U)
+#define UART_RX_BUFFER_MASK		(UART_RX_BUFFER_SIZE - 1U)
+
+#if ( (UART_RX_BUFFER_SIZE & UART_RX_BUFFER_MASK) != 0U ) || (UART_RX_BUFFER_SIZE > 128U)
+#error "UART_RX_BUFFER_SIZE must be a power of 2 and not bigger than 128"
+#endif
+
+/*
+ * Size of the Tx ring buffer used in TX_BUFFER_ENABLE mode
+ * Same rules of Rx ring buffer size (power of 2 and not bigger than 128)
+*/
+#define UART_TX_BUFFER_SIZE		(64U)
+#define UART_TX_BUFFER_MASK		(UART_TX_BUFFER_SIZE - 1U)
+
+#if ( (UART_TX_BUFFER_SIZE & UART_TX_BUFFER_MASK) != 0U ) || (UART_TX_BUFFER_SIZE > 128U)
+#error "UART_TX_BUFFER_SIZE must be a power of 2 and not bigger than 128"
+#endif
+
+/*
+ * Period of calling UART_timeoutTick from a timer ISR in milli seconds
+ * all timeouts of UART functions are counted with this tick
+*/
+#define UART_TIMEOUT_TICK_MS	(1U)
 
 /************************************************************************************************/
 
@@ -41,6 +116,22 @@
 /********************************** User Define Data Types **************************************/
 
 
+/********************************************************************************
+
+ [Enumuration Name]:		UART_StatusType
+
+ [Enumuration Description]: Result of UART operations which may fail
+
+*********************************************************************************/
+typedef enum{
+
+	UART_OK,
+	UART_TIMEOUT,
+	UART_BUSY
+
+}UART_StatusType;
+
+
 /********************************************************************************
 
  [Enumuration Name]:		UART_InterruptModeType
@@ -76,6 +167,87 @@ typedef enum{
 
 }UART_ParityModeType;
 
+
+/********************************************************************************
+
+ [Enumuration Name]:		UART_RxBufferModeType
+
+ [Enumuration Description]: Used to decide how received bytes are handled
+ 	 	 	 	 	 	    (Directly from UDR register, or saved by Rx ISR
+							in a ring buffer till the application reads them)
+
+*********************************************************************************/
+typedef enum{
+
+	RX_BUFFER_DISABLE,
+	RX_BUFFER_ENABLE
+
+}UART_RxBufferModeType;
+
+
+/********************************************************************************
+
+ [Enumuration Name]:		UART_TxBufferModeType
+
+ [Enumuration Description]: Used to decide how bytes are transmitted
+ 	 	 	 	 	 	    (Busy wait on UDRE flag for every byte, or queued
+							in a ring buffer and drained by Data Register Empty ISR)
+
+*********************************************************************************/
+typedef enum{
+
+	TX_BUFFER_DISABLE,
+	TX_BUFFER_ENABLE
+
+}UART_TxBufferModeType;
+
+/********************************************************************************
+
+ [Enumuration Name]:		UART_MultiProcessorModeType
+
+ [Enumuration Description]: Used to decide Multi-processor Communication mode (MPCM)
+ 	 	 	 	 	 	    with 9 bit characters, the 9th bit is 1 in address frames
+ 	 	 	 	 	 	    - Master sends address frames to select one slave
+ 	 	 	 	 	 	    - Slave ignores data frames (No Rx interrupt) till
+ 	 	 	 	 	 	      its own address or broadcast address is received
+
+*********************************************************************************/
+typedef enum{
+
+	MPCM_DISABLE,
+	MPCM_MASTER,
+	MPCM_SLAVE
+
+}UART_MultiProcessorModeType;
+
+
+/********************************************************************************
+
+ [Structure Name]: 		  UART_StatisticsType
+
+ [Structure Description]: Counters of the UART link used to tune its speed
+ 	 	 	 	 	 	  (Error counters are counted only for bytes read
+ 	 	 	 	 	 	  by the driver, not by the Rx callback of the application)
+
+*********************************************************************************/
+typedef struct{
+
+	uint32		BytesSent;			/* Number of bytes written to UDR										*/
+
+	uint32		BytesReceived;		/* Number of bytes read from UDR										*/
+
+	uint16		OverrunErrors;		/* Bytes lost as UDR was not read in time (DOR flag)					*/
+
+	uint16		FramingErrors;		/* Bytes with wrong stop bit, usually a baud rate mismatch (FE flag)	*/
+
+	uint16		ParityErrors;		/* Bytes with wrong parity bit (PE flag)								*/
+
+	uint16		DroppedBytes;		/* Bytes dropped by Rx ISR as Rx ring buffer was full					*/
+
+	uint8		MaxRxOccupancy;		/* Highest number of bytes waited in Rx ring buffer						*/
+
+}UART_StatisticsType;
+
 /********************************************************************************
 
  [Structure Name]: 		  UART_ConfigType
@@ -95,8 +267,20 @@ typedef struct{
 	UART_ParityModeType			ParityMode;			/* You can find this value @UART_ParityModeType
 	 	 	 	 	 	 	 	 	 	 	 	 	   Used to decide Parity bit mode (Even, odd parity , or disabled) 			*/
 
-	uint32						BaudRate;			/* Baud rate used with UART Operations
-	 	 	 	 	 	 	 	 	 	 	 	 	   it vary from 9600 till 115200 or even 921600 with laptop using USB-TTL	*/
+	UART_RxBufferModeType		RxBufferMode;		/* You can find this value @UART_RxBufferModeType
+	 	 	 	 	 	 	 	 	 	 	 	 	   Used to save received bytes in a ring buffer from Rx ISR
+	 	 	 	 	 	 	 	 	 	 	 	 	   (Rx Interrupt will be enabled automatically in this mode)	*/
+
+	UART_TxBufferModeType		TxBufferMode;		/* You can find this value @UART_TxBufferModeType
+	 	 	 	 	 	 	 	 	 	 	 	 	   Used to queue sent bytes in a ring buffer drained by UDRE ISR
+	 	 	 	 	 	 	 	 	 	 	 	 	   (UART_sendByte returns immediately if the buffer has space)	*/
+
+	UART_MultiProcessorModeType	MultiProcessorMode;	/* You can find this value @UART_MultiProcessorModeType
+	 	 	 	 	 	 	 	 	 	 	 	 	   Used to share one bus between a master and many slaves
+	 	 	 	 	 	 	 	 	 	 	 	 	   (9 bit characters are used if it is not disabled)			*/
+
+	uint8						Address;			/* Own address of this slave in MPCM_SLAVE mode
+	 	 	 	 	 	 	 	 	 	 	 	 	   (Not used in other modes)									*/
 
 }UART_ConfigType;
 
@@ -111,12 +295,15 @@ typedef struct{
  [Function Name]:	UART_init
 
  [Description]:		Used to initialize UART Module
- 	 	 	 	 	- Choose BaudRate prefered
+ 	 	 	 	 	- BaudRate is chosen at compile time @UART_BAUD_RATE
  	 	 	 	 	- Decide Stop bits number
  	 	 	 	 	- Decide operating mode (Tx Interrupt, Rx Interrupt, both, or polling mode)
  	 	 	 	 	- Decide Parity  mode	(Even, Odd, or no parity)
+ 	 	 	 	 	- Decide Rx mode (Directly from UDR or through Rx ring buffer)
+ 	 	 	 	 	- Decide Tx mode (Busy wait on UDRE or through Tx ring buffer)
+ 	 	 	 	 	- Decide Multi-processor mode (Disabled, Master, or Slave with its address)
  	 	 	 	 	- Enable Tx, Rx both
-					- 8 bit Data transfer mode
+					- 8 bit Data transfer mode (9 bit in Multi-processor mode)
 					- Asynchronous Mode (UART not USART)
 
  [Args]:			config_Ptr
@@ -173,10 +360,33 @@ void UART_setCallBackTx(void (*f_ptr)(void));
 
 
 
+/********************************************************************************
+ [Function Name]:	UART_setCallBackTxDrain
+
+ [Description]:		Function Callback called from Data Register Empty ISR when
+ 	 	 	 	 	the last queued byte is moved to UDR (Tx ring buffer is empty)
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to void function
+					which will save address of Drain Handler Function in main
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_setCallBackTxDrain(void (*f_ptr)(void));
+
+
+
 /********************************************************************************
  [Function Name]:	UART_sendByte
 
  [Description]:		Function used to send byte through UART communication protocol
+ 	 	 	 	 	(Called while Global Interrupts are disabled, the Tx block
+ 	 	 	 	 	is sent by hand before it instead of waiting for UDRE ISR)
 
  [Args]:			data
 
@@ -192,6 +402,105 @@ void UART_sendByte(const uint8 data);
 
 
 
+/********************************************************************************
+ [Function Name]:	UART_sendAddress
+
+ [Description]:		Function used to send an address frame (9th bit is 1) in
+ 	 	 	 	 	MPCM_MASTER mode to select the slave of the next data bytes
+ 	 	 	 	 	- Waits until all queued bytes are sent first
+ 	 	 	 	 	- UART_MPCM_BROADCAST_ADDRESS selects all slaves
+
+ [Args]:			address
+
+ [in]				address: Address of the slave
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_sendAddress(uint8 address);
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_sendBuffer
+
+ [Description]:		Function used to send number of bytes as one operation
+ 	 	 	 	 	- Bytes are moved to UDR directly from the caller buffer by
+ 	 	 	 	 	  Data Register Empty ISR (No copy and no busy wait)
+ 	 	 	 	 	- Buffer must NOT be changed till the callback is called
+ 	 	 	 	 	- Bytes sent by UART_sendByte after it are sent after the block
+ 	 	 	 	 	(Global Interrupts must be enabled)
+
+ [Args]:			buffer, length, f_ptr
+
+ [in]				buffer: Pointer to the bytes to be sent
+ 	 	 	 	 	length: Number of bytes to be sent
+ 	 	 	 	 	f_ptr:	Pointer to void function called from ISR when the last
+ 	 	 	 	 	 	 	byte is moved to UDR (NULL_PTR if not needed)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			UART_OK if the transfer started, UART_BUSY if a previous
+ 	 	 	 	 	block or queued bytes are still being sent
+**********************************************************************************/
+UART_StatusType UART_sendBuffer(const uint8 *buffer, uint8 length, void (*f_ptr)(void));
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_receiveBuffer
+
+ [Description]:		Function used to receive number of bytes as one operation
+ 	 	 	 	 	- Bytes already waiting in Rx ring buffer are taken first
+ 	 	 	 	 	- Rest of bytes are saved by Rx ISR directly in the caller buffer
+ 	 	 	 	 	- Buffer must NOT be used till the callback is called
+ 	 	 	 	 	(Global Interrupts must be enabled)
+
+ [Args]:			buffer, length, f_ptr
+
+ [in]				length: Number of bytes to be received
+ 	 	 	 	 	f_ptr:	Pointer to void function called when the last byte
+ 	 	 	 	 	 	 	is received (NULL_PTR if not needed)
+
+ [out]				buffer: Pointer to an array to save the received bytes on it
+
+ [in/out]			None
+
+ [Returns]:			UART_OK if the transfer started, UART_BUSY if a previous
+ 	 	 	 	 	block is still being received
+**********************************************************************************/
+UART_StatusType UART_receiveBuffer(uint8 *buffer, uint8 length, void (*f_ptr)(void));
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_flush
+
+ [Description]:		Function used to wait until all queued bytes are drained
+ 	 	 	 	 	and the last byte is completely shifted out of Tx pin
+ 	 	 	 	 	(Called while Global Interrupts are disabled, the Tx block
+ 	 	 	 	 	and queued bytes are sent by hand instead of waiting for
+ 	 	 	 	 	UDRE ISR)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_flush(void);
+
+
+
 /********************************************************************************
  [Function Name]:	UART_recieveByte
 
@@ -211,6 +520,131 @@ uint8 UART_recieveByte(void);
 
 
 
+/********************************************************************************
+ [Function Name]:	UART_recieveByteTimeout
+
+ [Description]:		Function used to receive a byte through UART Communication Protocol
+ 	 	 	 	 	but waiting for a bounded time only
+ 	 	 	 	 	(UART_timeoutTick must be called periodically from a timer ISR)
+
+ [Args]:			data, timeout
+
+ [in]				timeout: Maximum time to wait in milli seconds
+
+ [out]				data: Pointer to unsigned char to save the received byte on it
+
+ [in/out]			None
+
+ [Returns]:			UART_OK if a byte is received, UART_TIMEOUT otherwise
+**********************************************************************************/
+UART_StatusType UART_recieveByteTimeout(uint8 *data, uint16 timeout);
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_receiveBufferTimeout
+
+ [Description]:		Function used to receive number of bytes through UART
+ 	 	 	 	 	within a bounded time for the whole buffer
+ 	 	 	 	 	(UART_timeoutTick must be called periodically from a timer ISR)
+
+ [Args]:			buffer, length, timeout
+
+ [in]				length:	 Number of bytes to be received
+ 	 	 	 	 	timeout: Maximum time to wait for all bytes in milli seconds
+
+ [out]				buffer: Pointer to an array to save the received bytes on it
+
+ [in/out]			None
+
+ [Returns]:			UART_OK if all bytes are received, UART_TIMEOUT otherwise
+**********************************************************************************/
+UART_StatusType UART_receiveBufferTimeout(uint8 *buffer, uint8 length, uint16 timeout);
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_timeoutTick
+
+ [Description]:		Time base of UART timeouts, it should be given as a callback
+ 	 	 	 	 	to a timer which interrupts every UART_TIMEOUT_TICK_MS
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_timeoutTick(void);
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_available
+
+ [Description]:		Function used to know how many bytes are waiting in the
+ 	 	 	 	 	Rx ring buffer (RX_BUFFER_ENABLE mode)
+ 	 	 	 	 	In RX_BUFFER_DISABLE mode it returns 1 if RXC flag is set
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Number of received bytes ready to be read
+**********************************************************************************/
+uint8 UART_available(void);
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_peek
+
+ [Description]:		Function used to get the oldest received byte without
+ 	 	 	 	 	removing it from the Rx ring buffer (Non blocking)
+ 	 	 	 	 	Only works in RX_BUFFER_ENABLE mode as reading UDR clears it
+
+ [Args]:			data
+
+ [in]				None
+
+ [out]				data: Pointer to unsigned char to save the byte on it
+
+ [in/out]			None
+
+ [Returns]:			TRUE if a byte is available, FALSE if buffer is empty
+**********************************************************************************/
+uint8 UART_peek(uint8 *data);
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_read
+
+ [Description]:		Function used to get the oldest received byte and remove it
+ 	 	 	 	 	from the Rx ring buffer (Non blocking)
+
+ [Args]:			data
+
+ [in]				None
+
+ [out]				data: Pointer to unsigned char to save the byte on it
+
+ [in/out]			None
+
+ [Returns]:			TRUE if a byte is read, FALSE if buffer is empty
+**********************************************************************************/
+uint8 UART_read(uint8 *data);
+
+
+
 /********************************************************************************
  [Function Name]:	UART_sendString
 
@@ -254,4 +688,65 @@ void UART_sendString(const uint8 *Str);
 void UART_receiveString(uint8 *Str); // Receive until #
 
 
+
+
+/********************************************************************************
+ [Function Name]:	UART_getStatistics
+
+ [Description]:		Function used to take a copy of the link statistics
+ 	 	 	 	 	(Copied with Global Interrupts disabled to be consistent)
+
+ [Args]:			statistics_Ptr
+
+ [in]				None
+
+ [out]				statistics_Ptr: Pointer to structure to save the statistics on it
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_getStatistics(UART_StatisticsType *statistics_Ptr);
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_resetStatistics
+
+ [Description]:		Function used to clear all the link statistics counters
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_resetStatistics(void);
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_dumpStatistics
+
+ [Description]:		Function used to give every statistics counter with its name
+ 	 	 	 	 	to a print function (LCD, another UART, debugger, ...)
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to function which prints one counter
+ 	 	 	 	 	 	   (Name string and its value)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_dumpStatistics(void (*f_ptr)(const uint8 *name, uint32 value));
+
+
 #endif /* UART_H_ */
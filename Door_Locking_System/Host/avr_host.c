@@ -0,0 +1,251 @@
+ /******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: avr_host.c
+ *
+ * Description: Source file for the registers and interrupt emulation of
+ * 				the Linux host build
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <sched.h>
+
+#include "avr_host.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* I/O Ports, only saved to be seen from a debugger */
+volatile uint8_t PORTA, DDRA, PINA;
+volatile uint8_t PORTB, DDRB, PINB;
+volatile uint8_t PORTC, DDRC, PINC;
+volatile uint8_t PORTD, DDRD, PIND;
+
+/* Status Register, Global Interrupts are disabled after reset like AVR */
+volatile uint8_t SREG = 0;
+
+/* TWI Registers */
+volatile uint8_t TWBR, TWSR, TWDR, TWAR;
+volatile uint8_t Host_twcrValue = HOST_TWCR_TAKEN;
+volatile uint8_t Host_twiModel = FALSE;
+
+/* ISRs of the emulated vectors */
+static void (*volatile g_isr[HOST_VECTORS_NUMBER])(void);
+
+/* Vectors requested by signals but not served yet (one bit for every vector) */
+static volatile sig_atomic_t g_pendingVectors = 0;
+
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Serve all pending vectors while the I-bit is set
+ * Called while all interrupt signals are blocked so it never runs twice at once
+*/
+static void Host_dispatch(void){
+
+	/* Iteration variable */
+	uint8 vector;
+
+	while( BIT_IS_SET(SREG,7) && (g_pendingVectors != 0) ){
+
+		for(vector = 0; vector < HOST_VECTORS_NUMBER; vector++){
+
+			if( BIT_IS_SET(g_pendingVectors,vector) && BIT_IS_SET(SREG,7) ){
+
+				g_pendingVectors &= ~(1 << vector);
+
+				if(g_isr[vector] != NULL_PTR){
+
+					/* I-bit is cleared while the ISR is running (No nested interrupts) */
+					CLEAR_BIT(SREG,7);
+					(*g_isr[vector])();
+					SET_BIT(SREG,7);
+				}
+			}
+		}
+	}
+}
+
+
+/* Handler of all interrupt signals (SIGALRM of a timer or sigqueue carries the vector, SIGIO is UART Rx) */
+static void Host_signalHandler(int signal, siginfo_t *info, void *context){
+
+	/* Save errno as the ISR may change it */
+	int savedErrno = errno;
+
+	(void)context;
+
+	if(signal == SIGIO){
+
+		g_pendingVectors |= (1 << HOST_VECTOR_USART_RXC);
+	}
+	else if( ( (info -> si_code == SI_TIMER) || (info -> si_code == SI_QUEUE) ) &&
+			 (info -> si_value.sival_int < (int)HOST_VECTORS_NUMBER) ){
+
+		g_pendingVectors |= (1 << info -> si_value.sival_int);
+	}
+
+	/* Served later by the next signal or sei() if the I-bit is cleared now */
+	Host_dispatch();
+
+	errno = savedErrno;
+}
+
+
+/* Install the signal handlers before the firmware main starts */
+__attribute__((constructor)) static void Host_init(void){
+
+	struct sigaction action;
+
+	action.sa_sigaction	= Host_signalHandler;
+	action.sa_flags		= SA_SIGINFO | SA_RESTART;
+
+	/* Interrupt signals never interrupt each other */
+	sigemptyset(&action.sa_mask);
+	sigaddset(&action.sa_mask, SIGALRM);
+	sigaddset(&action.sa_mask, SIGIO);
+
+	sigaction(SIGALRM, &action, NULL);
+	sigaction(SIGIO, &action, NULL);
+}
+
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	Host_setInterrupt
+
+ [Description]:		Used to register the ISR of an emulated interrupt vector
+
+ [Args]:			vector, f_ptr
+
+ [in]				vector: Interrupt vector @HOST_VECTOR
+ 	 	 	 	 	f_ptr:	Pointer to the ISR function (NULL_PTR to remove it)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Host_setInterrupt(uint8 vector, void (*f_ptr)(void)){
+
+	if(vector < HOST_VECTORS_NUMBER){
+
+		g_isr[vector] = f_ptr;
+	}
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Host_sei
+
+ [Description]:		Used to set the I-bit and serve the pending interrupts
+ 	 	 	 	 	(Host version of sei())
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Host_sei(void){
+
+	sigset_t signals, oldSignals;
+
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGALRM);
+	sigaddset(&signals, SIGIO);
+
+	/* Block interrupt signals while serving the pending ones */
+	sigprocmask(SIG_BLOCK, &signals, &oldSignals);
+
+	SET_BIT(SREG,7);
+	Host_dispatch();
+
+	sigprocmask(SIG_SETMASK, &oldSignals, NULL);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Host_twcr
+
+ [Description]:		Used for every access of TWCR (Host version of the register)
+ 	 	 	 	 	Waits till the TWI model takes the last TWCR write (It sets
+ 	 	 	 	 	HOST_TWCR_TAKEN), no wait if there is no TWI model
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Pointer to the TWCR value
+**********************************************************************************/
+volatile uint8_t* Host_twcr(void){
+
+	/* Model is a thread, the CPU is given to it on every access (Firmware polls TWINT) */
+	if(Host_twiModel == TRUE){
+
+		do{
+			sched_yield();
+
+		}while( (Host_twcrValue & HOST_TWCR_TAKEN) == 0 );
+	}
+
+	return &Host_twcrValue;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Host_delayUs
+
+ [Description]:		Used to sleep for a number of micro seconds
+ 	 	 	 	 	(Host version of _delay_ms and _delay_us)
+
+ [Args]:			us
+
+ [in]				us: Sleep time in micro seconds
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Host_delayUs(uint32 us){
+
+	struct timespec remaining;
+
+	remaining.tv_sec	= us / 1000000UL;
+	remaining.tv_nsec	= (long)(us % 1000000UL) * 1000L;
+
+	/* Interrupt signals wake up the sleep, so continue the rest of it */
+	while( (nanosleep(&remaining, &remaining) != 0) && (errno == EINTR) ){}
+}
@@ -0,0 +1,119 @@
+ /******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: avr_host.h
+ *
+ * Description: Header file for the interrupt emulation of the Linux host build
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *
+ * Note: Every interrupt source is a Unix signal (Timers: SIGALRM, UART: SIGIO,
+ * 		 hardware models: SIGALRM sent by sigqueue with the vector)
+ * 		 A signal only marks its vector as pending, pending vectors are served
+ * 		 while the I-bit of SREG is set exactly like AVR (I-bit is cleared
+ * 		 during the ISR so ISRs never nest)
+ *******************************************************************************/
+
+#ifndef AVR_HOST_H_
+#define AVR_HOST_H_
+
+/****************************************** Includes *********************************************/
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "micro_config.h"
+
+/************************************************************************************************/
+
+
+/******************************************* Macros *********************************************/
+
+/* Emulated interrupt vectors (Lower number is served first like AVR vector table) */
+#define HOST_VECTOR_TIMER2			(0U)
+#define HOST_VECTOR_TIMER1			(1U)
+#define HOST_VECTOR_TIMER0			(2U)
+#define HOST_VECTOR_USART_RXC		(3U)
+#define HOST_VECTOR_TWI				(4U)
+#define HOST_VECTORS_NUMBER			(5U)
+
+/*
+ * Reserved bit 1 of TWCR is set by a TWI model when it takes a TWCR write
+ * (Firmware writes never set it), Host_twiModel is TRUE while a model runs
+*/
+#define HOST_TWCR_TAKEN				(1U << 1)
+
+extern volatile uint8_t Host_twcrValue;
+extern volatile uint8_t Host_twiModel;
+
+/************************************************************************************************/
+
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	Host_setInterrupt
+
+ [Description]:		Used to register the ISR of an emulated interrupt vector
+
+ [Args]:			vector, f_ptr
+
+ [in]				vector: Interrupt vector @HOST_VECTOR
+ 	 	 	 	 	f_ptr:	Pointer to the ISR function (NULL_PTR to remove it)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Host_setInterrupt(uint8 vector, void (*f_ptr)(void));
+
+
+
+/********************************************************************************
+ [Function Name]:	Host_sei
+
+ [Description]:		Used to set the I-bit and serve the pending interrupts
+ 	 	 	 	 	(Host version of sei())
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Host_sei(void);
+
+
+
+/********************************************************************************
+ [Function Name]:	Host_delayUs
+
+ [Description]:		Used to sleep for a number of micro seconds
+ 	 	 	 	 	(Host version of _delay_ms and _delay_us)
+
+ [Args]:			us
+
+ [in]				us: Sleep time in micro seconds
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Host_delayUs(uint32 us);
+
+
+#endif /* AVR_HOST_H_ */
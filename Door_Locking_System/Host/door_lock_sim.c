@@ -0,0 +1,105 @@
+ /******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: door_lock_sim.c
+ *
+ * Description: Launcher of the Linux host build
+ * 				Runs Control ECU and HMI ECU firmware as two processes wired
+ * 				by a socketpair (The UART line). Keys of the HMI keypad are
+ * 				read from stdin and its LCD is printed on stdout
+ *
+ * 				Example: printf '12345 12345 - 12345' | ./door_lock_sim
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <libgen.h>
+#include <limits.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+/* Start one ECU program with its end of the UART line */
+static pid_t Sim_startEcu(const char *directory, const char *program, int lineFd, int otherFd, int keepStdin){
+
+	char path[PATH_MAX];
+	char fd[16];
+	int nullFd;
+	pid_t pid = fork();
+
+	if(pid != 0){
+
+		return pid;
+	}
+
+	close(otherFd);
+
+	/* Only HMI ECU reads the keypad from stdin */
+	if(!keepStdin){
+
+		nullFd = open("/dev/null", O_RDONLY);
+		dup2(nullFd, STDIN_FILENO);
+	}
+
+	snprintf(fd, sizeof(fd), "%d", lineFd);
+	setenv("UART_HOST_FD", fd, 1);
+	unsetenv("UART_HOST_DEVICE");
+
+	snprintf(path, sizeof(path), "%s/%s", directory, program);
+	execl(path, program, (char*)NULL);
+
+	perror(path);
+	_exit(127);
+}
+
+int main(void){
+
+	char self[PATH_MAX];
+	ssize_t length;
+	int line[2];
+	int status = 0;
+	pid_t control, hmi;
+
+	/* Programs are next to the launcher */
+	length = readlink("/proc/self/exe", self, sizeof(self) - 1);
+
+	if(length < 0){
+
+		perror("readlink");
+		return 1;
+	}
+
+	self[length] = '\0';
+
+	if(socketpair(AF_UNIX, SOCK_STREAM, 0, line) != 0){
+
+		perror("socketpair");
+		return 1;
+	}
+
+	control	= Sim_startEcu(dirname(self), "control_host", line[0], line[1], 0);
+	hmi		= Sim_startEcu(self, "hmi_host", line[1], line[0], 1);
+
+	close(line[0]);
+	close(line[1]);
+
+	/* Session ends when HMI ECU ends (End of keypad input) */
+	waitpid(hmi, &status, 0);
+
+	kill(control, SIGTERM);
+	waitpid(control, NULL, 0);
+
+	return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
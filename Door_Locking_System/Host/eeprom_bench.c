@@ -0,0 +1,177 @@
+ /******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: eeprom_bench.c
+ *
+ * Description: Benchmark of the Control ECU storage (Password journal and user
+ * 				passwords table) on the emulated External EEPROM
+ * 				Times include the emulated write cycles (10 ms by default)
+ *
+ * 				Usage: ./eeprom_bench [password changes]
+ * 				EEPROM_HOST_WRITE_CYCLE_US=0 ./eeprom_bench measures the code only
+ * 				EEPROM_HOST_BIT_RATE=400000 ./eeprom_bench paces the I2C bus too
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "external_eeprom_host.h"
+#include "journal.h"
+#include "credentials.h"
+
+/* Print one EEPROM statistics counter */
+static void Bench_printStatistic(const uint8 *name, uint32 value){
+
+	printf("  %-6s %lu\n", (const char*)name, (unsigned long)value);
+}
+
+/* Time now in micro seconds */
+static double Bench_now(void){
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (now.tv_sec * 1e6) + (now.tv_nsec / 1e3);
+}
+
+/* Password digits of a number */
+static void Bench_code(uint32 number, uint8 *code){
+
+	uint8 i;
+
+	for(i = 0; i < CREDENTIALS_CODE_LENGTH; i++){
+
+		code[i] = (uint8)(number % 10U);
+		number /= 10U;
+	}
+}
+
+/* Print time of one operation and the EEPROM counters of it */
+static void Bench_report(const char *name, long count, double start){
+
+	double elapsed = Bench_now() - start;
+
+	printf("%s: %ld in %.1f ms, %.3f us each\n", name, count, elapsed / 1e3, elapsed / count);
+	EEPROM_hostDumpStatistics(Bench_printStatistic);
+	EEPROM_hostResetStatistics();
+}
+
+int main(int argc, char *argv[]){
+
+	long changes = (argc > 1) ? atol(argv[1]) : 100;
+
+	uint8 code[CREDENTIALS_CODE_LENGTH];
+	uint8 stored[CREDENTIALS_CODE_LENGTH];
+	uint8 userId;
+	uint32 user;
+	long i, errors = 0;
+	double start;
+
+	if(changes <= 0){
+
+		fprintf(stderr, "usage: %s [password changes]\n", argv[0]);
+		return 1;
+	}
+
+	EEPROM_init();
+	EEPROM_hostResetStatistics();
+
+	start = Bench_now();
+	Journal_init();
+	Credentials_init();
+	Bench_report("boot scan (journal and users)", 1, start);
+
+	start = Bench_now();
+
+	for(i = 0; i < changes; i++){
+
+		Bench_code((uint32)i, code);
+
+		if(Journal_append(code) != JOURNAL_OK){
+
+			errors++;
+		}
+	}
+
+	Bench_report("password changes", changes, start);
+
+	start = Bench_now();
+
+	for(i = 0; i < changes; i++){
+
+		if(Journal_read(code) != JOURNAL_OK){
+
+			errors++;
+		}
+	}
+
+	Bench_report("password reads", changes, start);
+
+	start = Bench_now();
+
+	for(user = 0; user < CREDENTIALS_MAX_USERS; user++){
+
+		Bench_code(10000U + (user * 7919U), code);
+
+		if(Credentials_enroll((uint8)user, code) != CREDENTIALS_OK){
+
+			errors++;
+		}
+	}
+
+	Bench_report("users enrolled", CREDENTIALS_MAX_USERS, start);
+
+	start = Bench_now();
+
+	for(user = 0; user < CREDENTIALS_MAX_USERS; user++){
+
+		Bench_code(10000U + (user * 7919U), code);
+
+		if( (Credentials_find(code, &userId) != CREDENTIALS_OK) || (userId != user) ){
+
+			errors++;
+		}
+	}
+
+	Bench_report("user password checks", CREDENTIALS_MAX_USERS, start);
+
+	/*
+	 * Firmware checks the main password on its SRAM copy, so a wrong password
+	 * is timed here as a check without it: the main password is read from the
+	 * journal then the users are searched (Digits 9 only are never used)
+	*/
+	Bench_code(99999U, code);
+
+	start = Bench_now();
+
+	for(i = 0; i < changes; i++){
+
+		if( (Journal_read(stored) != JOURNAL_OK) || (memcmp(stored, code, CREDENTIALS_CODE_LENGTH) == 0) ){
+
+			errors++;
+		}
+
+		if(Credentials_find(code, &userId) != CREDENTIALS_NOT_FOUND){
+
+			errors++;
+		}
+	}
+
+	Bench_report("wrong password checks (journal read and users search)", changes, start);
+
+	printf("errors %ld\n", errors);
+
+	return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,459 @@
+ /******************************************************************************
+ *
+ * Module: External EEPROM
+ *
+ * File Name: external_eeprom_host.c
+ *
+ * Description: Linux host version of the External EEPROM Memory
+ * 				Memory is a memory mapped image file (EEPROM_HOST_IMAGE) or
+ * 				RAM erased to 0xFF like a new EEPROM, with the size, page and
+ * 				write cycle behaviour of the selected 24Cxx part (EEPROM_DEVICE)
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "external_eeprom_host.h"
+#include "avr_host.h"
+
+/* Bytes sent for the address of a transaction (Device address and word address) */
+#define EEPROM_HOST_ADDRESS_BYTES	(1U + EEPROM_WORD_ADDRESS_SIZE)
+
+/* Memory of the emulated EEPROM (Mapped image file or anonymous memory) */
+static uint8 *g_memory = NULL_PTR;
+
+/* End of the running write cycle */
+static struct timespec g_cycleEnd;
+static uint8 g_cycleRunning = FALSE;
+
+/* Write cycle time and bus bit rate (0: bus transfers are NOT paced) */
+static long g_cycleTimeUs = EEPROM_WRITE_CYCLE_MS * 1000L;
+static long g_bitRate = 0;
+
+static EEPROM_HostStatisticsType g_statistics;
+
+/* Background write (EEPROM_writeBlockAsync), its pages are written from the Timer0 tick */
+static volatile uint8 g_asyncBusy = FALSE;
+static uint16 g_asyncAddress;
+static const uint8 *g_asyncData;
+static uint16 g_asyncLength;
+static void (*volatile g_asyncCallBackPtr)(EEPROM_StatusType status) = NULL_PTR;
+
+
+/* Time difference in micro seconds (end - start) */
+static long EEPROM_hostElapsedUs(const struct timespec *start, const struct timespec *end){
+
+	return ( (end->tv_sec - start->tv_sec) * 1000000L ) + ( (end->tv_nsec - start->tv_nsec) / 1000L );
+}
+
+
+/* Sleep till an absolute monotonic time (Emulated interrupts may wake it early) */
+static void EEPROM_hostSleepUntil(const struct timespec *deadline){
+
+	while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL) == EINTR){
+	}
+}
+
+
+/* Write cycle ended (ACK poll of a background write, it never sleeps) */
+static uint8 EEPROM_hostCycleEnded(void){
+
+	struct timespec now;
+
+	if(g_cycleRunning == FALSE){
+
+		return TRUE;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	if(EEPROM_hostElapsedUs(&now, &g_cycleEnd) > 0){
+
+		return FALSE;
+	}
+
+	g_cycleRunning = FALSE;
+
+	return TRUE;
+}
+
+
+/* Device answers only after the write cycle ends (ACK polling of the driver) */
+static void EEPROM_hostWaitReady(void){
+
+	struct timespec now;
+
+	if(g_cycleRunning == FALSE){
+
+		return;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	if(EEPROM_hostElapsedUs(&now, &g_cycleEnd) > 0){
+
+		g_statistics.BusyWaitUs += (uint32)EEPROM_hostElapsedUs(&now, &g_cycleEnd);
+		EEPROM_hostSleepUntil(&g_cycleEnd);
+	}
+
+	g_cycleRunning = FALSE;
+}
+
+
+/* Time of the transaction bytes on the bus (9 clocks every byte, START and STOP) */
+static void EEPROM_hostBusTransfer(uint32 bytes){
+
+	struct timespec deadline;
+	long transferUs;
+
+	if(g_bitRate <= 0){
+
+		return;
+	}
+
+	transferUs = (long)( ( ( (uint64)bytes * 9U ) + 2U ) * 1000000ULL / (uint64)g_bitRate );
+
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+	deadline.tv_nsec += (transferUs % 1000000L) * 1000L;
+	deadline.tv_sec  += (transferUs / 1000000L) + (deadline.tv_nsec / 1000000000L);
+	deadline.tv_nsec %= 1000000000L;
+
+	EEPROM_hostSleepUntil(&deadline);
+
+	g_statistics.BusUs += (uint32)transferUs;
+}
+
+
+/* Write transaction: bytes wrap at the page end, then the write cycle starts */
+static EEPROM_StatusType EEPROM_hostWrite(uint16 u16addr, const uint8 *data, uint8 length){
+
+	uint16 pageStart = (uint16)(u16addr - (u16addr % EEPROM_PAGE_SIZE));
+	uint8 i;
+
+	if(u16addr >= EEPROM_SIZE){
+
+		/* No device answers at this address */
+		return EEPROM_NACK;
+	}
+
+	EEPROM_hostWaitReady();
+	EEPROM_hostBusTransfer(EEPROM_HOST_ADDRESS_BYTES + length);
+
+	/* Only the low address bits count inside the page (Extra bytes overwrite the page start) */
+	for(i = 0; i < length; i++){
+
+		g_memory[pageStart + ( (u16addr + i) % EEPROM_PAGE_SIZE )] = data[i];
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &g_cycleEnd);
+
+	g_cycleEnd.tv_nsec += (g_cycleTimeUs % 1000000L) * 1000L;
+	g_cycleEnd.tv_sec  += (g_cycleTimeUs / 1000000L) + (g_cycleEnd.tv_nsec / 1000000000L);
+	g_cycleEnd.tv_nsec %= 1000000000L;
+
+	g_cycleRunning = TRUE;
+
+	g_statistics.WriteCycles++;
+	g_statistics.WriteBytes += length;
+
+	return EEPROM_OK;
+}
+
+
+/* Write the next page of the background write (Till the page end) */
+static EEPROM_StatusType EEPROM_hostAsyncPage(void){
+
+	uint8 chunk = (uint8)(EEPROM_PAGE_SIZE - (g_asyncAddress % EEPROM_PAGE_SIZE));
+	EEPROM_StatusType status;
+
+	if(chunk > g_asyncLength){
+
+		chunk = (uint8)g_asyncLength;
+	}
+
+	status = EEPROM_hostWrite(g_asyncAddress, g_asyncData, chunk);
+
+	g_asyncAddress	+= chunk;
+	g_asyncData		+= chunk;
+	g_asyncLength	-= chunk;
+
+	return status;
+}
+
+
+/* End the background write then give its result to the callback */
+static void EEPROM_hostAsyncEnd(EEPROM_StatusType status){
+
+	g_asyncBusy = FALSE;
+
+	if(g_asyncCallBackPtr != NULL_PTR){
+
+		(*g_asyncCallBackPtr)(status);
+	}
+}
+
+
+/* Other accesses wait for the background write like the firmware driver */
+static void EEPROM_hostWaitAsync(void){
+
+	while(g_asyncBusy == TRUE){
+	}
+}
+
+
+/* Addressed sequential read (Address, repeated START, device address and data) */
+static EEPROM_StatusType EEPROM_hostRead(uint16 u16addr, uint8 *data, uint16 length){
+
+	if( ((uint32)u16addr + length) > EEPROM_SIZE ){
+
+		/* No device answers at this address */
+		return EEPROM_NACK;
+	}
+
+	EEPROM_hostWaitReady();
+	EEPROM_hostBusTransfer(EEPROM_HOST_ADDRESS_BYTES + 1U + length);
+
+	memcpy(data, &g_memory[u16addr], length);
+
+	g_statistics.Reads++;
+	g_statistics.ReadBytes += length;
+
+	return EEPROM_OK;
+}
+
+
+/* Map the image file, bytes beyond its old end are erased (0xFF) */
+static uint8* EEPROM_hostMapImage(const char *path){
+
+	struct stat status;
+	uint8 *memory;
+	int fd = open(path, O_RDWR | O_CREAT, 0644);
+
+	if( (fd < 0) || (fstat(fd, &status) != 0) || (ftruncate(fd, EEPROM_SIZE) != 0) ){
+
+		fprintf(stderr, "EEPROM host: can NOT open %s\n", path);
+		exit(1);
+	}
+
+	memory = mmap(NULL, EEPROM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if(memory == MAP_FAILED){
+
+		fprintf(stderr, "EEPROM host: can NOT map %s\n", path);
+		exit(1);
+	}
+
+	if(status.st_size < EEPROM_SIZE){
+
+		memset(&memory[status.st_size], 0xFF, EEPROM_SIZE - status.st_size);
+	}
+
+	return memory;
+}
+
+
+void EEPROM_init(void)
+{
+	const char *image	= getenv("EEPROM_HOST_IMAGE");
+	const char *cycle	= getenv("EEPROM_HOST_WRITE_CYCLE_US");
+	const char *rate	= getenv("EEPROM_HOST_BIT_RATE");
+
+	if(g_memory == NULL_PTR){
+
+		if(image != NULL){
+
+			g_memory = EEPROM_hostMapImage(image);
+		}
+		else{
+
+			g_memory = mmap(NULL, EEPROM_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if(g_memory == MAP_FAILED){
+
+				perror("EEPROM host");
+				exit(1);
+			}
+
+			memset(g_memory, 0xFF, EEPROM_SIZE);
+		}
+	}
+
+	g_cycleTimeUs	= (cycle != NULL) ? atol(cycle) : (EEPROM_WRITE_CYCLE_MS * 1000L);
+	g_bitRate		= (rate != NULL) ? atol(rate) : 0;
+	g_cycleRunning	= FALSE;
+}
+
+EEPROM_StatusType EEPROM_writeByte(uint16 u16addr, uint8 u8data)
+{
+	EEPROM_hostWaitAsync();
+
+	return EEPROM_hostWrite(u16addr, &u8data, 1U);
+}
+
+EEPROM_StatusType EEPROM_readByte(uint16 u16addr, uint8 *u8data)
+{
+	EEPROM_hostWaitAsync();
+
+	return EEPROM_hostRead(u16addr, u8data, 1U);
+}
+
+EEPROM_StatusType EEPROM_writePage(uint16 u16addr, const uint8 *data, uint8 length)
+{
+	EEPROM_hostWaitAsync();
+
+	if( ( (u16addr % EEPROM_PAGE_SIZE) + length ) > EEPROM_PAGE_SIZE ){
+
+		return EEPROM_PAGE_OVERFLOW;
+	}
+
+	return EEPROM_hostWrite(u16addr, data, length);
+}
+
+EEPROM_StatusType EEPROM_writeBlock(uint16 u16addr, const uint8 *data, uint16 length)
+{
+	EEPROM_StatusType status = EEPROM_OK;
+	uint8 chunk;
+
+	EEPROM_hostWaitAsync();
+
+	if( ((uint32)u16addr + length) > EEPROM_SIZE ){
+
+		/* No device answers at this address */
+		return EEPROM_NACK;
+	}
+
+	/* One page write for every page like the firmware driver */
+	while( (length > 0U) && (status == EEPROM_OK) ){
+
+		chunk = (uint8)(EEPROM_PAGE_SIZE - (u16addr % EEPROM_PAGE_SIZE));
+
+		if(chunk > length){
+
+			chunk = (uint8)length;
+		}
+
+		status = EEPROM_hostWrite(u16addr, data, chunk);
+
+		u16addr	+= chunk;
+		data	+= chunk;
+		length	-= chunk;
+	}
+
+	return status;
+}
+
+EEPROM_StatusType EEPROM_readBlock(uint16 u16addr, uint8 *data, uint16 length)
+{
+	EEPROM_hostWaitAsync();
+
+	return EEPROM_hostRead(u16addr, data, length);
+}
+
+EEPROM_StatusType EEPROM_writeBlockAsync(uint16 u16addr, const uint8 *data, uint16 length, void (*f_ptr)(EEPROM_StatusType status))
+{
+	EEPROM_StatusType status;
+
+	uint8 sreg = SREG;
+
+	cli();
+
+	if(g_asyncBusy == TRUE){
+
+		SREG = sreg;
+		return EEPROM_BUSY;
+	}
+
+	g_asyncBusy			= TRUE;
+	g_asyncCallBackPtr	= f_ptr;
+	g_asyncAddress		= u16addr;
+	g_asyncData			= data;
+	g_asyncLength		= length;
+
+	SREG = sreg;
+
+	if(length == 0){
+
+		/* Nothing to write, callback is called at once */
+		EEPROM_hostAsyncEnd(EEPROM_OK);
+		return EEPROM_OK;
+	}
+
+	/* Previous write cycle may still run, the tick writes the first page then */
+	if(EEPROM_hostCycleEnded() == TRUE){
+
+		status = EEPROM_hostAsyncPage();
+
+		if(status != EEPROM_OK){
+
+			g_asyncBusy = FALSE;
+			return status;
+		}
+	}
+
+	return EEPROM_OK;
+}
+
+void EEPROM_writeCycleTick(void)
+{
+	EEPROM_StatusType status;
+
+	if( (g_asyncBusy == FALSE) || (EEPROM_hostCycleEnded() == FALSE) ){
+
+		return;
+	}
+
+	if(g_asyncLength == 0){
+
+		EEPROM_hostAsyncEnd(EEPROM_OK);
+		return;
+	}
+
+	status = EEPROM_hostAsyncPage();
+
+	if(status != EEPROM_OK){
+
+		EEPROM_hostAsyncEnd(status);
+	}
+}
+
+/* TWI bus is emulated inside the EEPROM accesses, no transaction can get stuck */
+void TWI_timeoutTick(void)
+{
+}
+
+void EEPROM_hostGetStatistics(EEPROM_HostStatisticsType *statistics_Ptr)
+{
+	*statistics_Ptr = g_statistics;
+}
+
+void EEPROM_hostResetStatistics(void)
+{
+	memset(&g_statistics, 0, sizeof(g_statistics));
+}
+
+void EEPROM_hostDumpStatistics(void(*f_ptr)(const uint8 *name, uint32 value))
+{
+	f_ptr((const uint8*)"reads",	g_statistics.Reads);
+	f_ptr((const uint8*)"rbytes",	g_statistics.ReadBytes);
+	f_ptr((const uint8*)"cycles",	g_statistics.WriteCycles);
+	f_ptr((const uint8*)"wbytes",	g_statistics.WriteBytes);
+	f_ptr((const uint8*)"busyus",	g_statistics.BusyWaitUs);
+	f_ptr((const uint8*)"busus",	g_statistics.BusUs);
+}
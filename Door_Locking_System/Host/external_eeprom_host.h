@@ -0,0 +1,117 @@
+ /******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: external_eeprom_host.h
+ *
+ * Description: Header file for the statistics of the emulated External EEPROM
+ * 				of the Linux host build
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *
+ * Note: EEPROM contents are a memory mapped image file (EEPROM_HOST_IMAGE=path)
+ * 		 kept between runs, or erased RAM (0xFF) if no file is given
+ * 		 - Page writes wrap at the page end like the real device
+ * 		 - Every write starts a write cycle (EEPROM_HOST_WRITE_CYCLE_US, 10 ms
+ * 		   by default), next access waits for its end like ACK polling
+ * 		 - EEPROM_HOST_BIT_RATE=400000 paces every transfer like a real I2C bus
+ * 		 - Background writes (EEPROM_writeBlockAsync) write their next page from
+ * 		   EEPROM_writeCycleTick once the write cycle ended, without any sleep
+ *******************************************************************************/
+
+#ifndef EXTERNAL_EEPROM_HOST_H_
+#define EXTERNAL_EEPROM_HOST_H_
+
+/****************************************** Includes *********************************************/
+
+#include "external_eeprom.h"
+
+/************************************************************************************************/
+
+
+/********************************** User Define Data Types **************************************/
+
+/********************************************************************************
+
+ [Structure Name]:			EEPROM_HostStatisticsType
+
+ [Structure Description]:	Counters of the emulated EEPROM accesses
+
+*********************************************************************************/
+typedef struct{
+
+	uint32 Reads;			/* Read transactions						*/
+	uint32 ReadBytes;		/* Bytes read								*/
+	uint32 WriteCycles;		/* Write transactions (One write cycle each)	*/
+	uint32 WriteBytes;		/* Bytes written							*/
+	uint32 BusyWaitUs;		/* Time waited for write cycles to end		*/
+	uint32 BusUs;			/* Time of the paced bus transfers			*/
+
+}EEPROM_HostStatisticsType;
+
+/************************************************************************************************/
+
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	EEPROM_hostGetStatistics
+
+ [Description]:		Used to copy the emulated EEPROM counters
+
+ [Args]:			statistics_Ptr
+
+ [in]				None
+
+ [out]				statistics_Ptr: Pointer to save the counters on it
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void EEPROM_hostGetStatistics(EEPROM_HostStatisticsType *statistics_Ptr);
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_hostResetStatistics
+
+ [Description]:		Used to clear the emulated EEPROM counters
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void EEPROM_hostResetStatistics(void);
+
+
+/********************************************************************************
+ [Function Name]:	EEPROM_hostDumpStatistics
+
+ [Description]:		Used to give every counter with its name to a print function
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to function which prints one counter
+ 	 	 	 	 	 	   (Name string and its value)
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void EEPROM_hostDumpStatistics(void(*f_ptr)(const uint8 *name, uint32 value));
+
+#endif /* EXTERNAL_EEPROM_HOST_H_ */
@@ -0,0 +1,32 @@
+ /******************************************************************************
+ *
+ * Module: Host - AVR interrupts
+ *
+ * File Name: interrupt.h
+ *
+ * Description: Stand-in of <avr/interrupt.h> for the Linux host build
+ * 				Interrupts are emulated by Unix signals, they are served only
+ * 				while the I-bit of SREG is set (see avr_host.c)
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+/* Serve interrupts requested while the I-bit was cleared */
+void Host_sei(void);
+
+/* ISRs of the host build are normal functions registered by Host_setInterrupt */
+#define ISR(vector)		void vector(void)
+
+#define sei()			Host_sei()
+#define cli()			(SREG &= (uint8_t)~(1U << 7))
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
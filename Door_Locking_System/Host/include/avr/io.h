@@ -0,0 +1,92 @@
+ /******************************************************************************
+ *
+ * Module: Host - AVR registers
+ *
+ * File Name: io.h
+ *
+ * Description: Stand-in of <avr/io.h> for the Linux host build
+ * 				Registers are plain variables (defined in avr_host.c) so the
+ * 				firmware code which only sets pins (LEDs, Buzzer, Motors)
+ * 				compiles and runs unchanged, TWI registers are served by a
+ * 				bus model thread where it is needed (twi_bench.c)
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+#include <stdint.h>
+
+/* I/O Ports */
+extern volatile uint8_t PORTA, DDRA, PINA;
+extern volatile uint8_t PORTB, DDRB, PINB;
+extern volatile uint8_t PORTC, DDRC, PINC;
+extern volatile uint8_t PORTD, DDRD, PIND;
+
+/* Status Register (Bit 7 is Global Interrupt Enable) */
+extern volatile uint8_t SREG;
+
+/*
+ * TWI Registers (Driven by the bus model of twi_bench.c)
+ * Every TWCR access first waits for the model to take the last TWCR write,
+ * so TWINT written by the firmware is never read back as a set flag
+*/
+extern volatile uint8_t TWBR, TWSR, TWDR, TWAR;
+volatile uint8_t* Host_twcr(void);
+#define TWCR	(*Host_twcr())
+
+/* TWCR Bits */
+#define TWINT	7
+#define TWEA	6
+#define TWSTA	5
+#define TWSTO	4
+#define TWWC	3
+#define TWEN	2
+#define TWIE	0
+
+/* Port A Pins */
+#define PA0		0
+#define PA1		1
+#define PA2		2
+#define PA3		3
+#define PA4		4
+#define PA5		5
+#define PA6		6
+#define PA7		7
+
+/* Port B Pins */
+#define PB0		0
+#define PB1		1
+#define PB2		2
+#define PB3		3
+#define PB4		4
+#define PB5		5
+#define PB6		6
+#define PB7		7
+
+/* Port C Pins */
+#define PC0		0
+#define PC1		1
+#define PC2		2
+#define PC3		3
+#define PC4		4
+#define PC5		5
+#define PC6		6
+#define PC7		7
+
+/* Port D Pins */
+#define PD0		0
+#define PD1		1
+#define PD2		2
+#define PD3		3
+#define PD4		4
+#define PD5		5
+#define PD6		6
+#define PD7		7
+
+#endif /* HOST_AVR_IO_H_ */
@@ -0,0 +1,29 @@
+ /******************************************************************************
+ *
+ * Module: Host - AVR delay
+ *
+ * File Name: delay.h
+ *
+ * Description: Stand-in of <util/delay.h> for the Linux host build
+ * 				Busy wait delays become real sleeps (Interrupts keep running)
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+/*
+ * Sleep for a number of micro seconds (Resumed if a signal interrupts it)
+ * unsigned long is uint32 of std_types.h
+*/
+void Host_delayUs(unsigned long us);
+
+#define _delay_ms(ms)	Host_delayUs( (unsigned long)( (ms) * 1000.0 ) )
+#define _delay_us(us)	Host_delayUs( (unsigned long)(us) )
+
+#endif /* HOST_UTIL_DELAY_H_ */
@@ -0,0 +1,63 @@
+ /******************************************************************************
+ *
+ * Module: KEYPAD
+ *
+ * File Name: keypad_host.c
+ *
+ * Description: Linux host version of the Keypad driver
+ * 				Keys are read from stdin so a session can be typed or scripted
+ * 				- '0' .. '9' give the numbers 0 .. 9 like the 4x4 keypad
+ * 				- '+', '-', '*', '%', '=' give their ASCII codes
+ * 				- 'e' gives 13 (Enter key)
+ * 				- White spaces are ignored, end of input ends the program
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#include "keypad.h"
+
+/*
+ * Description: Function to know which button pressed on keypad
+ * @Param:		None
+ * @Return:		Button Pressed (uint8)
+ */
+uint8 KeyPad_getPressedKey(void){
+
+	int key;
+
+	while(1){
+
+		key = getchar();
+
+		if(key == EOF){
+
+			printf("KEYPAD end of input\n");
+			exit(0);
+		}
+
+		if(isspace(key)){
+
+			continue;
+		}
+
+		if(isdigit(key)){
+
+			return (uint8)(key - '0');
+		}
+
+		if(key == 'e'){
+
+			return 13;
+		}
+
+		return (uint8)key;
+	}
+}
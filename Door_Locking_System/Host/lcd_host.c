@@ -0,0 +1,133 @@
+ /******************************************************************************
+ *
+ * Module: LCD
+ *
+ * File Name: lcd_host.c
+ *
+ * Description: Linux host version of the LCD Driver
+ * 				DDRAM of the 16x2 LCD is emulated and the two visible rows
+ * 				are printed on stdout after every change
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "LCD.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Number of visible columns of every row */
+#define LCD_HOST_COLUMNS	(16U)
+
+/* Display Data RAM of the LCD (Row 0 starts at 0x00, Row 1 starts at 0x40) */
+static uint8 g_ddram[128];
+
+/* Address counter of the LCD */
+static uint8 g_address = 0;
+
+/* Last printed rows (Firmware rewrites the same text in loops) */
+static uint8 g_shown[2][LCD_HOST_COLUMNS];
+
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Print the two visible rows if they are changed */
+static void LCD_hostShow(void){
+
+	if( (memcmp(g_shown[0], &g_ddram[0x00], LCD_HOST_COLUMNS) == 0) &&
+		(memcmp(g_shown[1], &g_ddram[0x40], LCD_HOST_COLUMNS) == 0) ){
+
+		return;
+	}
+
+	memcpy(g_shown[0], &g_ddram[0x00], LCD_HOST_COLUMNS);
+	memcpy(g_shown[1], &g_ddram[0x40], LCD_HOST_COLUMNS);
+
+	printf("LCD |%.16s|%.16s|\n", (const char*)&g_ddram[0x00], (const char*)&g_ddram[0x40]);
+	fflush(stdout);
+}
+
+
+/* Write one character at the address counter then increment it */
+static void LCD_hostWrite(uint8 chr){
+
+	g_ddram[g_address & 0x7F] = chr;
+	g_address = (g_address + 1) & 0x7F;
+}
+
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void LCD_Init(void){
+
+	LCD_sendCommand(CLEAR_COMMAND);
+}
+
+void LCD_sendCommand(uint8 command){
+
+	if(command == CLEAR_COMMAND){
+
+		memset(g_ddram, ' ', sizeof(g_ddram));
+		g_address = 0;
+		LCD_hostShow();
+	}
+	else if(command & SET_CURSOR_LOCATION){
+
+		g_address = command & 0x7F;
+	}
+}
+
+void LCD_displayCharacter(uint8 chr){
+
+	LCD_hostWrite(chr);
+	LCD_hostShow();
+}
+
+void LCD_displayString(const uint8 *Str)
+{
+	uint8 i = 0;
+	while(Str[i] != '\0')
+	{
+		LCD_hostWrite(Str[i]);
+		i++;
+	}
+	LCD_hostShow();
+}
+
+void LCD_goToRowColumn(uint8 row,uint8 col)
+{
+	/* Same addresses of the AVR driver */
+	static const uint8 rowAddress[4] = {0x00, 0x40, 0x10, 0x50};
+
+	LCD_sendCommand( (rowAddress[row & 0x03] + col) | SET_CURSOR_LOCATION );
+}
+
+void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str)
+{
+	LCD_goToRowColumn(row,col);
+	LCD_displayString((const uint8*)Str);
+}
+
+void LCD_intgerToString(int data)
+{
+	char buff[16];
+	snprintf(buff, sizeof(buff), "%d", data);
+	LCD_displayString((const uint8*)buff);
+}
+
+void LCD_clearScreen(void)
+{
+	LCD_sendCommand(CLEAR_COMMAND);
+}
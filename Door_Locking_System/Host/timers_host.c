@@ -0,0 +1,250 @@
+ /******************************************************************************
+ *
+ * Module: Timers
+ *
+ * File Name: timers_host.c
+ *
+ * Description: Linux host version of the AVR Timers driver
+ * 				Every AVR timer is a POSIX interval timer with the same period
+ * 				(Prescaler and counts of the configuration structure) and its
+ * 				interrupt is emulated with SIGALRM
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <signal.h>
+#include <time.h>
+
+#include "timers.h"
+#include "avr_host.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Global variables to hold the address of the call back function for timer 0 in the application */
+static void (*volatile g_callBackPtrTimer0)(void) = NULL_PTR;
+
+/* Global variables to hold the address of the call back function for timer 1 in the application */
+static void (*volatile g_callBackPtrTimer1)(void) = NULL_PTR;
+
+/* Global variables to hold the address of the call back function for timer 2 in the application */
+static void (*volatile g_callBackPtrTimer2)(void) = NULL_PTR;
+
+/* POSIX timers of Timer0, Timer1 and Timer2 */
+static timer_t g_hostTimer[3];
+
+/* Flags to know which POSIX timers are created */
+static uint8 g_hostTimerCreated[3] = {FALSE, FALSE, FALSE};
+
+/* Divider of every Timer_PrescalerType value (0 means the timer does NOT count) */
+static const uint16 g_prescalerDivider[] = {0, 1, 8, 64, 256, 1024, 0, 0};
+
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+static void Host_timer0Isr(void){
+
+	if(g_callBackPtrTimer0 != NULL_PTR){
+
+		(*g_callBackPtrTimer0)();
+	}
+}
+
+static void Host_timer1Isr(void){
+
+	if(g_callBackPtrTimer1 != NULL_PTR){
+
+		(*g_callBackPtrTimer1)();
+	}
+}
+
+static void Host_timer2Isr(void){
+
+	if(g_callBackPtrTimer2 != NULL_PTR){
+
+		(*g_callBackPtrTimer2)();
+	}
+}
+
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	Timer_init
+
+ [Description]:		Function to Initiate Timer Driver
+ 					- Period is (Counts x Prescaler / F_CPU) like AVR
+ 					- Counts are (CompareValue + 1) in CTC modes or
+ 					  (Top + 1 - InitialValue) in Normal mode
+ 					- Output compare pins are not emulated
+
+ [Args]:			Config_Ptr
+
+ [in]				Config_Ptr: Pointer to Timer Configuration Structure
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Timer_init(const Timer_ConfigType * config_Ptr){
+
+	/* Id of the timer */
+	uint8 id = config_Ptr -> TimerID;
+
+	/* Number of counts of one period */
+	uint32 counts;
+
+	/* Period of the timer in nano seconds */
+	uint64 periodNs;
+
+	struct sigevent event;
+	struct itimerspec spec;
+
+	if( (id > TIMER_ID_2) || (config_Ptr -> Prescaler > EXTERNAL_RISING_CLOCK) ){
+
+		return;
+	}
+
+	/* Vector of this timer carried by SIGALRM */
+	if(g_hostTimerCreated[id] == FALSE){
+
+		event.sigev_notify			= SIGEV_SIGNAL;
+		event.sigev_signo			= SIGALRM;
+		event.sigev_value.sival_int	= ( (id == TIMER_ID_0) ? HOST_VECTOR_TIMER0 :
+										(id == TIMER_ID_1) ? HOST_VECTOR_TIMER1 : HOST_VECTOR_TIMER2 );
+
+		if(timer_create(CLOCK_MONOTONIC, &event, &g_hostTimer[id]) != 0){
+
+			return;
+		}
+
+		g_hostTimerCreated[id] = TRUE;
+	}
+
+	Host_setInterrupt(HOST_VECTOR_TIMER0, Host_timer0Isr);
+	Host_setInterrupt(HOST_VECTOR_TIMER1, Host_timer1Isr);
+	Host_setInterrupt(HOST_VECTOR_TIMER2, Host_timer2Isr);
+
+	if(config_Ptr -> TimerMode == NORMAL_MODE){
+
+		counts = ( (id == TIMER_ID_1) ? 65536UL : 256UL ) - config_Ptr -> InitialValue;
+	}
+	else{
+
+		counts = (uint32)(config_Ptr -> CompareValue) + 1UL;
+	}
+
+	periodNs = ( (uint64)counts * g_prescalerDivider[config_Ptr -> Prescaler] * 1000000000ULL ) / F_CPU;
+
+	/* Zero period stops the timer (No clock source) */
+	spec.it_interval.tv_sec		= (time_t)(periodNs / 1000000000ULL);
+	spec.it_interval.tv_nsec	= (long)(periodNs % 1000000000ULL);
+	spec.it_value				= spec.it_interval;
+
+	timer_settime(g_hostTimer[id], 0, &spec, NULL);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Timer0_setCallBack
+
+ [Description]:		Function Callback to serve Timer0 ISR Code
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to void function
+					which will save address of ISR Handler Function in main
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Timer0_setCallBack(void (*f_ptr)(void)){
+	g_callBackPtrTimer0 = f_ptr;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Timer1_setCallBack
+
+ [Description]:		Function Callback to serve Timer1 ISR Code
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to void function
+					which will save address of ISR Handler Function in main
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Timer1_setCallBack(void (*f_ptr)(void)){
+	g_callBackPtrTimer1 = f_ptr;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Timer2_setCallBack
+
+ [Description]:		Function Callback to serve Timer2 ISR Code
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to void function
+					which will save address of ISR Handler Function in main
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Timer2_setCallBack(void (*f_ptr)(void)){
+	g_callBackPtrTimer2 = f_ptr;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	Timer_stop
+
+ [Description]:		Function used to stop timer by disarming its POSIX timer
+
+ [Args]:			timerID
+
+ [in]				timerID: used to decide which timer to stop
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void Timer_stop(uint8 timerID){
+
+	struct itimerspec spec = {{0, 0}, {0, 0}};
+
+	if( (timerID <= TIMER_ID_2) && (g_hostTimerCreated[timerID] == TRUE) ){
+
+		timer_settime(g_hostTimer[timerID], 0, &spec, NULL);
+	}
+}
@@ -0,0 +1,536 @@
+ /******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: twi_bench.c
+ *
+ * Description: Test and benchmark of the TWI driver (i2c.c) of the Control ECU
+ * 				on a model of the TWI hardware with a 24C16 EEPROM on the bus
+ * 				- The model is a thread which takes every TWCR write (TWCR
+ * 				  reads of the firmware wait for it), acts on the writes with
+ * 				  TWINT like the TWI Module, then raises TWI interrupt
+ * 				- 24C16 keeps written bytes in its page buffer till STOP, then
+ * 				  NACKs its address during the write cycle (START or REPEATED
+ * 				  START before STOP drops the written bytes like the real part)
+ * 				- A stuck bus is checked with the model stopped and timer ticks
+ * 				  given by hand
+ *
+ * 				Usage: ./twi_bench [transactions]
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "i2c.h"
+#include "avr_host.h"
+
+/* TWI ISR of i2c.c (ISRs of the host build are normal functions) */
+void TWI_vect(void);
+
+/* Emulated 24C16: 8 blocks of 256 bytes at 0x50 to 0x57, 16 bytes pages */
+#define BENCH_EEPROM_ADDRESS		(0x50U)
+#define BENCH_EEPROM_SIZE			(2048U)
+#define BENCH_PAGE_SIZE				(16U)
+#define BENCH_WRITE_CYCLE_US		(2000L)
+
+/* Bus phases of the model */
+#define BENCH_BUS_FREE				(0U)	/* No START on the bus						*/
+#define BENCH_BUS_ADDRESS			(1U)	/* START sent, SLA+R/W is the next byte		*/
+#define BENCH_BUS_WRITE				(2U)	/* EEPROM receives (Word address then data)	*/
+#define BENCH_BUS_READ				(3U)	/* EEPROM sends from its address counter	*/
+#define BENCH_BUS_IGNORED			(4U)	/* Address NACKed, STOP or START is next	*/
+
+/* EEPROM memory, page buffer and address counter */
+static uint8 g_memory[BENCH_EEPROM_SIZE];
+static uint8 g_page[BENCH_PAGE_SIZE];
+static uint8 g_pageUsed[BENCH_PAGE_SIZE];
+static uint16 g_pageStart;
+static uint16 g_counter;
+static uint8 g_wordAddressNext;
+static uint8 g_pageBytes;
+
+/* End of the write cycle */
+static struct timespec g_cycleEnd;
+
+static uint8 g_phase = BENCH_BUS_FREE;
+
+/* Model state shared with the firmware thread */
+static volatile uint8 g_running = TRUE;
+static volatile uint8 g_stall = FALSE;
+static volatile uint32 g_writeCycles = 0;
+static volatile uint32 g_droppedWrites = 0;
+static volatile uint32 g_recoveries = 0;
+
+/* Result of the ISR transactions */
+static volatile uint8 g_done;
+static volatile TWI_StatusType g_status;
+
+
+/* Time now plus a number of micro seconds */
+static void Bench_deadline(struct timespec *time, long us){
+
+	clock_gettime(CLOCK_MONOTONIC, time);
+
+	time->tv_nsec += (us % 1000000L) * 1000L;
+	time->tv_sec  += (us / 1000000L) + (time->tv_nsec / 1000000000L);
+	time->tv_nsec %= 1000000000L;
+}
+
+
+/* EEPROM is in its write cycle (It does not acknowledge its address) */
+static uint8 Bench_eepromBusy(void){
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return ( (now.tv_sec < g_cycleEnd.tv_sec) ||
+			 ( (now.tv_sec == g_cycleEnd.tv_sec) && (now.tv_nsec < g_cycleEnd.tv_nsec) ) ) ? TRUE : FALSE;
+}
+
+
+/* STOP: written bytes go from the page buffer to the memory, the write cycle starts */
+static void Bench_eepromStop(void){
+
+	uint8 i;
+
+	if( (g_phase == BENCH_BUS_WRITE) && (g_pageBytes > 0) ){
+
+		for(i = 0; i < BENCH_PAGE_SIZE; i++){
+
+			if(g_pageUsed[i] == TRUE){
+
+				g_memory[g_pageStart + i] = g_page[i];
+			}
+		}
+
+		Bench_deadline(&g_cycleEnd, BENCH_WRITE_CYCLE_US);
+		g_writeCycles++;
+	}
+
+	g_pageBytes	= 0;
+	g_phase		= BENCH_BUS_FREE;
+}
+
+
+/* START or REPEATED START: written bytes without STOP are dropped */
+static void Bench_eepromStart(void){
+
+	if( (g_phase == BENCH_BUS_WRITE) && (g_pageBytes > 0) ){
+
+		g_droppedWrites++;
+	}
+
+	g_pageBytes	= 0;
+	g_phase		= BENCH_BUS_ADDRESS;
+}
+
+
+/* Byte after SLA+W: word address first, then data in the page buffer (Wraps at the page end) */
+static void Bench_eepromWrite(uint8 data){
+
+	if(g_wordAddressNext == TRUE){
+
+		g_counter			= (uint16)( (g_counter & 0x0700U) | data );
+		g_wordAddressNext	= FALSE;
+		return;
+	}
+
+	if(g_pageBytes == 0){
+
+		g_pageStart = (uint16)(g_counter - (g_counter % BENCH_PAGE_SIZE));
+		memset(g_pageUsed, FALSE, sizeof(g_pageUsed));
+	}
+
+	g_page[g_counter % BENCH_PAGE_SIZE]		= data;
+	g_pageUsed[g_counter % BENCH_PAGE_SIZE]	= TRUE;
+	g_pageBytes++;
+
+	g_counter = (uint16)(g_pageStart + ( (g_counter + 1U) % BENCH_PAGE_SIZE ));
+}
+
+
+/* Serve one TWCR write with TWINT like the TWI Module, then set TWINT and raise the interrupt */
+static void Bench_busEvent(uint8 control){
+
+	union sigval vector;
+	uint8 status = TW_BUS_ERROR;
+	uint8 sla;
+
+	if(BIT_IS_SET(control,TWSTO)){
+
+		Bench_eepromStop();
+		__atomic_and_fetch(&Host_twcrValue, (uint8)~(1U << TWSTO), __ATOMIC_SEQ_CST);
+
+		/* STOP alone does not set TWINT */
+		if(BIT_IS_CLEAR(control,TWSTA)){
+
+			return;
+		}
+	}
+
+	if(BIT_IS_SET(control,TWSTA)){
+
+		status = ( (g_phase == BENCH_BUS_FREE) ? TW_START : TW_REP_START );
+		Bench_eepromStart();
+	}
+	else if(g_phase == BENCH_BUS_ADDRESS){
+
+		sla = TWDR;
+
+		if( ( (sla >> 1) & 0x78U ) == BENCH_EEPROM_ADDRESS && (Bench_eepromBusy() == FALSE) ){
+
+			/* Block bits of the device address are the memory address bits 8 to 10 */
+			g_counter = (uint16)( ( (uint16)( (sla >> 1) & 0x07U ) << 8 ) | (g_counter & 0x00FFU) );
+
+			if(sla & 1U){
+
+				g_phase	= BENCH_BUS_READ;
+				status	= TW_MT_SLA_R_ACK;
+			}
+			else{
+
+				g_phase				= BENCH_BUS_WRITE;
+				g_wordAddressNext	= TRUE;
+				status				= TW_MT_SLA_W_ACK;
+			}
+		}
+		else{
+
+			g_phase	= BENCH_BUS_IGNORED;
+			status	= ( (sla & 1U) ? TW_MT_SLA_R_NACK : TW_MT_SLA_W_NACK );
+		}
+	}
+	else if(g_phase == BENCH_BUS_WRITE){
+
+		Bench_eepromWrite(TWDR);
+		status = TW_MT_DATA_ACK;
+	}
+	else if(g_phase == BENCH_BUS_READ){
+
+		TWDR		= g_memory[g_counter];
+		g_counter	= (uint16)( (g_counter + 1U) % BENCH_EEPROM_SIZE );
+		status		= ( BIT_IS_SET(control,TWEA) ? TW_MR_DATA_ACK : TW_MR_DATA_NACK );
+	}
+
+	TWSR = (uint8)( status | (TWSR & 0x03U) );
+
+	__atomic_or_fetch(&Host_twcrValue, (uint8)(1U << TWINT), __ATOMIC_SEQ_CST);
+
+	if(BIT_IS_SET(control,TWIE)){
+
+		vector.sival_int = HOST_VECTOR_TWI;
+		sigqueue(getpid(), SIGALRM, vector);
+	}
+}
+
+
+/* TWI Module: takes every TWCR write, acts on the writes with TWINT (Interrupt signals go to the firmware thread) */
+static void* Bench_bus(void *argument){
+
+	sigset_t signals;
+	uint8 control;
+	uint8 enabled = FALSE;
+
+	(void)argument;
+
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGALRM);
+	sigaddset(&signals, SIGIO);
+	pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+	while(g_running == TRUE){
+
+		control = Host_twcrValue;
+
+		if(control & HOST_TWCR_TAKEN){
+
+			/* No new write */
+			sched_yield();
+			continue;
+		}
+
+		/* Take the write, TWINT is cleared by writing one to it */
+		if(!__atomic_compare_exchange_n(&Host_twcrValue, &control, (uint8)( (control | HOST_TWCR_TAKEN) & ~(1U << TWINT) ),
+										FALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)){
+			continue;
+		}
+
+		if(BIT_IS_CLEAR(control,TWEN)){
+
+			/* TWI Module disabled (Bus recovery drives the pins by hand), the bus is free after it */
+			if(enabled == TRUE){
+
+				g_recoveries++;
+			}
+
+			enabled	= FALSE;
+			g_phase	= BENCH_BUS_FREE;
+		}
+		else{
+
+			enabled = TRUE;
+
+			if( BIT_IS_SET(control,TWINT) && (g_stall == FALSE) ){
+
+				Bench_busEvent(control);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+
+/* Time now in micro seconds */
+static double Bench_now(void){
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (now.tv_sec * 1e6) + (now.tv_nsec / 1e3);
+}
+
+
+/* Callback of the ISR transactions */
+static void Bench_transactionDone(TWI_StatusType status){
+
+	g_status	= status;
+	g_done		= TRUE;
+}
+
+
+/* Run one ISR transaction and wait for its callback (TWI_TIMEOUT if it does not end in 1 second) */
+static TWI_StatusType Bench_run(TWI_TransactionType *transaction){
+
+	double start = Bench_now();
+
+	transaction->CallBack = Bench_transactionDone;
+
+	g_done = FALSE;
+
+	if(TWI_submitTransaction(transaction) != TWI_OK){
+
+		return TWI_BUSY;
+	}
+
+	while(g_done == FALSE){
+
+		if( (Bench_now() - start) > 1e6 ){
+
+			return TWI_TIMEOUT;
+		}
+
+		sched_yield();
+	}
+
+	return g_status;
+}
+
+
+/* Wait for the write cycle by ACK polling with polling transfers */
+static TWI_StatusType Bench_waitCycle(uint8 device){
+
+	TWI_StatusType status;
+	uint16 poll;
+
+	for(poll = 0; poll < 1000U; poll++){
+
+		status = TWI_transfer(device, NULL_PTR, 0, NULL_PTR, 0);
+
+		if(status != TWI_ADDRESS_NACK){
+
+			return status;
+		}
+
+		Host_delayUs(100);
+	}
+
+	return TWI_ADDRESS_NACK;
+}
+
+
+int main(int argc, char *argv[]){
+
+	long count = (argc > 1) ? atol(argv[1]) : 1000;
+
+	TWI_ConfigType config = {ADDRESS_OF_MC_IN_SLAVE_MODE, FAST_MODE_400KB, INTERRUPT_MODE_DISABLE, SLAVE_MODE_DISABLE};
+	TWI_TransactionType transaction;
+	TWI_TransactionType write;
+	TWI_TransactionType queued;
+	pthread_t bus;
+
+	/* 0x0120: block 1, word address 0x20 */
+	uint8 device = (uint8)(BENCH_EEPROM_ADDRESS | 0x01U);
+	uint8 frame[1U + BENCH_PAGE_SIZE];
+	uint8 data[BENCH_PAGE_SIZE];
+	uint8 wordAddress = 0x20U;
+	uint8 queuedFrame[1U + BENCH_PAGE_SIZE];
+	uint8 queuedData[BENCH_PAGE_SIZE];
+	uint8 tick;
+	long i, errors = 0;
+	double start;
+
+	if(count <= 0){
+
+		fprintf(stderr, "usage: %s [transactions]\n", argv[0]);
+		return 1;
+	}
+
+	memset(g_memory, 0xFF, sizeof(g_memory));
+
+	/* Bus lines are pulled up */
+	SET_BIT(PINC,TWI_SDA);
+	SET_BIT(PINC,TWI_SCL);
+
+	Host_setInterrupt(HOST_VECTOR_TWI, TWI_vect);
+	Host_twiModel = TRUE;
+	pthread_create(&bus, NULL, Bench_bus, NULL);
+
+	TWI_init(&config);
+	sei();
+
+	/* Page write with a polling transfer */
+	frame[0] = wordAddress;
+
+	for(i = 0; i < (long)BENCH_PAGE_SIZE; i++){
+
+		frame[1 + i] = (uint8)(0xA0U + i);
+	}
+
+	if( (TWI_transfer(device, frame, sizeof(frame), NULL_PTR, 0) != TWI_OK) || (Bench_waitCycle(device) != TWI_OK) ||
+		(memcmp(&g_memory[0x0120], &frame[1], BENCH_PAGE_SIZE) != 0) ){
+
+		printf("polling page write failed\n");
+		errors++;
+	}
+
+	/* Write then read with a polling transfer: word address, REPEATED START, SLA+R, 16 bytes */
+	memset(data, 0, sizeof(data));
+
+	if( (TWI_transfer(device, &wordAddress, 1, data, BENCH_PAGE_SIZE) != TWI_OK) || (memcmp(data, &frame[1], BENCH_PAGE_SIZE) != 0) ){
+
+		printf("polling write then read failed\n");
+		errors++;
+	}
+
+	/* Page write from TWI ISR with a read of it queued behind: STOP must commit the page, so the read gets NACK */
+	queuedFrame[0] = 0x40U;
+
+	for(i = 0; i < (long)BENCH_PAGE_SIZE; i++){
+
+		queuedFrame[1 + i] = (uint8)(0x50U + i);
+	}
+
+	write.SlaveAddress	= device;
+	write.TxBuffer		= queuedFrame;
+	write.TxLength		= sizeof(queuedFrame);
+	write.RxBuffer		= NULL_PTR;
+	write.RxLength		= 0;
+	write.CallBack		= NULL_PTR;
+
+	transaction.SlaveAddress	= device;
+	transaction.TxBuffer		= &queuedFrame[0];
+	transaction.TxLength		= 1;
+	transaction.RxBuffer		= data;
+	transaction.RxLength		= BENCH_PAGE_SIZE;
+
+	if( (TWI_submitTransaction(&write) != TWI_OK) || (Bench_run(&transaction) != TWI_ADDRESS_NACK) ||
+		(Bench_waitCycle(device) != TWI_OK) || (Bench_run(&transaction) != TWI_OK) ||
+		(memcmp(data, &queuedFrame[1], BENCH_PAGE_SIZE) != 0) || (g_droppedWrites != 0) ){
+
+		printf("queued page write failed\n");
+		errors++;
+	}
+
+	/*
+	 * Stuck bus: the model stops, timer ticks end the running transaction with TWI_TIMEOUT and do no
+	 * bus recovery, the next submit from thread context recovers the bus then starts the queued one
+	*/
+	g_stall = TRUE;
+	g_done	= FALSE;
+
+	transaction.CallBack	= Bench_transactionDone;
+	queued					= transaction;
+	queued.RxBuffer			= queuedData;
+	queued.CallBack			= NULL_PTR;
+
+	memset(data, 0, sizeof(data));
+	memset(queuedData, 0, sizeof(queuedData));
+
+	(void)TWI_submitTransaction(&transaction);
+	(void)TWI_submitTransaction(&queued);
+
+	for(tick = 0; (tick <= TWI_TRANSACTION_STEP_TICKS) && (g_done == FALSE); tick++){
+
+		/* Timer ISR */
+		cli();
+		TWI_timeoutTick();
+		sei();
+	}
+
+	if( (g_done == FALSE) || (g_status != TWI_TIMEOUT) || (g_recoveries != 0) || (TWI_isBusy() == FALSE) ){
+
+		printf("stuck bus timeout failed\n");
+		errors++;
+	}
+
+	g_stall = FALSE;
+
+	if( (Bench_run(&transaction) != TWI_OK) || (g_recoveries != 1) || (memcmp(data, &queuedFrame[1], BENCH_PAGE_SIZE) != 0) ||
+		(memcmp(queuedData, &queuedFrame[1], BENCH_PAGE_SIZE) != 0) ){
+
+		printf("stuck bus recovery failed\n");
+		errors++;
+	}
+
+	/* Write then read from TWI ISR (Runs last, a failed transaction may leave the ISR running) */
+	start = Bench_now();
+
+	for(i = 0; i < count; i++){
+
+		memset(data, 0, sizeof(data));
+
+		transaction.SlaveAddress	= device;
+		transaction.TxBuffer		= &wordAddress;
+		transaction.TxLength		= 1;
+		transaction.RxBuffer		= data;
+		transaction.RxLength		= BENCH_PAGE_SIZE;
+
+		if( (Bench_run(&transaction) != TWI_OK) || (memcmp(data, &frame[1], BENCH_PAGE_SIZE) != 0) ){
+
+			printf("write then read (ISR) failed\n");
+			errors++;
+			break;
+		}
+	}
+
+	if(i == count){
+
+		printf("write then read (ISR): %ld in %.1f ms, %.1f us each\n", count, (Bench_now() - start) / 1e3, (Bench_now() - start) / count);
+	}
+
+	g_running = FALSE;
+	pthread_join(bus, NULL);
+	Host_twiModel = FALSE;
+
+	printf("cycles %lu dropped %lu recoveries %lu\n", (unsigned long)g_writeCycles, (unsigned long)g_droppedWrites, (unsigned long)g_recoveries);
+	printf("errors %ld\n", errors);
+
+	return (errors == 0) ? 0 : 1;
+}
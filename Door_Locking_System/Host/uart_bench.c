@@ -0,0 +1,155 @@
+ /******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: uart_bench.c
+ *
+ * Description: Round trip latency and throughput benchmark of the
+ * 				HMI/Control protocol on the Linux host build
+ * 				A server process echoes every request frame back with the same
+ * 				payload and the client measures every Protocol_request
+ *
+ * 				Usage: ./uart_bench [requests] [payload length]
+ * 				UART_HOST_BAUD=250000 ./uart_bench paces bytes like a real line
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "protocol.h"
+#include "timers.h"
+
+/* Type of the benchmark request frames */
+#define BENCH_REQUEST		(0x7AU)
+
+/* Print one UART statistics counter */
+static void Bench_printStatistic(const uint8 *name, uint32 value){
+
+	printf("  %-6s %lu\n", (const char*)name, (unsigned long)value);
+}
+
+/* Time now in micro seconds */
+static double Bench_now(void){
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (now.tv_sec * 1e6) + (now.tv_nsec / 1e3);
+}
+
+/* UART on the given line end and 1 ms Timer0 tick for UART timeouts */
+static void Bench_initEcu(int lineFd){
+
+	char fd[16];
+
+	UART_ConfigType uart_Struct		= {POLLING, STOP_BIT_1_BIT, NO_PARIT_BITS, RX_BUFFER_ENABLE, TX_BUFFER_ENABLE, MPCM_DISABLE, 0};
+	Timer_ConfigType timer0_Strut	= {TIMER_ID_0, CTC_MODE, NORMAL, NONE, FCPU_OVER_64, 0, 124};
+
+	snprintf(fd, sizeof(fd), "%d", lineFd);
+	setenv("UART_HOST_FD", fd, 1);
+
+	UART_init(&uart_Struct);
+	Timer_init(&timer0_Strut);
+	Timer0_setCallBack(UART_timeoutTick);
+
+	sei();
+}
+
+/* Echo every request with the same type and payload */
+static void Bench_server(void){
+
+	Protocol_FrameType request;
+
+	while(1){
+
+		Protocol_receiveFrame(&request);
+		Protocol_sendFrame(request.Type, request.Payload, request.Length);
+	}
+}
+
+int main(int argc, char *argv[]){
+
+	long requests	= (argc > 1) ? atol(argv[1]) : 1000;
+	uint8 length	= (argc > 2) ? (uint8)atoi(argv[2]) : PROTOCOL_MAX_PAYLOAD;
+
+	uint8 payload[PROTOCOL_MAX_PAYLOAD] = {0, 1, 2, 3, 4, 5, 6, 7};
+	Protocol_FrameType reply;
+	int line[2];
+	pid_t server;
+	long i, lost = 0;
+	double start, begin, latency;
+	double total = 0, minimum = 1e12, maximum = 0;
+
+	if(length > PROTOCOL_MAX_PAYLOAD){
+
+		length = PROTOCOL_MAX_PAYLOAD;
+	}
+
+	if( (requests <= 0) || (socketpair(AF_UNIX, SOCK_STREAM, 0, line) != 0) ){
+
+		fprintf(stderr, "usage: %s [requests] [payload length]\n", argv[0]);
+		return 1;
+	}
+
+	server = fork();
+
+	if(server == 0){
+
+		close(line[0]);
+		Bench_initEcu(line[1]);
+		Bench_server();
+	}
+
+	close(line[1]);
+	Bench_initEcu(line[0]);
+
+	begin = Bench_now();
+
+	for(i = 0; i < requests; i++){
+
+		payload[0] = (uint8)i;
+
+		start = Bench_now();
+
+		if(Protocol_request(BENCH_REQUEST, payload, length, &reply) != PROTOCOL_FRAME_READY){
+
+			lost++;
+			continue;
+		}
+
+		latency = Bench_now() - start;
+		total += latency;
+
+		if(latency < minimum){ minimum = latency; }
+		if(latency > maximum){ maximum = latency; }
+	}
+
+	total = (requests > lost) ? (total / (requests - lost)) : 0;
+
+	printf("requests %ld, payload %u bytes, lost %ld\n", requests, length, lost);
+	printf("round trip us: min %.1f avg %.1f max %.1f\n", minimum, total, maximum);
+	printf("throughput: %.0f requests/s, %.0f bytes/s (both directions)\n",
+		   requests / ((Bench_now() - begin) / 1e6),
+		   (requests * 2.0 * (length + PROTOCOL_FRAME_OVERHEAD)) / ((Bench_now() - begin) / 1e6));
+	printf("client UART statistics:\n");
+	UART_dumpStatistics(Bench_printStatistic);
+
+	kill(server, SIGTERM);
+	waitpid(server, NULL, 0);
+
+	return (lost == 0) ? 0 : 1;
+}
@@ -0,0 +1,1012 @@
+ /******************************************************************************
+ *
+ * Module: UART
+ *
+ * File Name: uart_host.c
+ *
+ * Description: Linux host version of the UART AVR driver
+ * 				- The serial line is a file descriptor (socketpair end given in
+ * 				  UART_HOST_FD, or a pty/tty path given in UART_HOST_DEVICE)
+ * 				- Rx ISR is emulated with SIGIO, it moves received bytes to the
+ * 				  same Rx ring buffer (or Rx block) of the AVR driver
+ * 				- Tx bytes are written directly, optionally paced to the time they
+ * 				  take on a real line of UART_HOST_BAUD baud (10 bits per byte,
+ * 				  11 bits in Multi-processor Communication mode)
+ * 				- In Multi-processor Communication mode every character is two
+ * 				  bytes on the line: 9th bit (1 for address) then the data
+ *
+ * Author: Islam Ehab
+ *
+ * Date: 18/10/2026
+ *
+ * Version: 1.0.0
+ *******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <termios.h>
+#include <sched.h>
+
+#include "uart.h"
+#include "avr_host.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Value of the saved 9th bit when no half character is waiting */
+#define UART_HOST_NO_NINTH_BIT		(0xFFU)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* File descriptor of the serial line */
+static int g_fd = -1;
+
+/* Time of one byte on the line in micro seconds (0 means no pacing) */
+static uint32 g_byteTimeUs = 0;
+
+/* Multi-processor Communication mode and own address of this slave */
+static UART_MultiProcessorModeType g_mpcmMode = MPCM_DISABLE;
+static uint8 g_mpcmAddress = 0;
+
+/* TRUE if this slave was selected by the last address frame (Always TRUE if not a slave) */
+static volatile uint8 g_mpcmSelected = TRUE;
+
+/* 9th bit of a character whose data byte did not arrive yet (UART_HOST_NO_NINTH_BIT if none) */
+static uint8 g_rxNinthBit = UART_HOST_NO_NINTH_BIT;
+
+/* Global variables to hold the address of the call back function for UART Rx Interrupt in the application */
+static void (*volatile g_callBackPtrUartRx)(void) = NULL_PTR;
+
+/* Global variables to hold the address of the call back function for UART Tx Interrupt in the application */
+static void (*volatile g_callBackPtrUartTx)(void) = NULL_PTR;
+
+/* Global variables to hold the address of the call back function when Tx ring buffer is drained */
+static void (*volatile g_callBackPtrUartTxDrain)(void) = NULL_PTR;
+
+/* Rx ring buffer filled by the emulated Rx ISR */
+static volatile uint8 g_rxBuffer[UART_RX_BUFFER_SIZE];
+
+/* Free running indices of the Rx ring buffer */
+static volatile uint8 g_rxHead = 0;
+static volatile uint8 g_rxTail = 0;
+
+/* Block filled by UART_receiveBuffer directly in the caller buffer (NULL_PTR if no block) */
+static uint8 * volatile g_rxBlockPtr = NULL_PTR;
+static volatile uint8 g_rxBlockLength = 0;
+static volatile uint8 g_rxBlockIndex = 0;
+
+/* Global variables to hold the address of the call back function when the Rx block is received */
+static void (*volatile g_callBackPtrUartRxBlock)(void) = NULL_PTR;
+
+/* Link statistics counted by the driver, read by UART_getStatistics */
+static volatile UART_StatisticsType g_statistics;
+
+/* Remaining ticks of the running timeout, decremented by UART_timeoutTick */
+static volatile uint16 g_timeoutTicks = 0;
+
+/* Flag set by UART_timeoutTick when the running timeout ends */
+static volatile uint8 g_timeoutExpired = FALSE;
+
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Write bytes to the line (After the time they need on a real line if paced) */
+static void UART_hostWriteLine(const uint8 *data, uint16 length, uint16 characters){
+
+	/* Number of written bytes */
+	uint16 written = 0;
+
+	/* Number of bytes of one write call */
+	ssize_t result;
+
+	struct pollfd line = {g_fd, POLLOUT, 0};
+
+	/* Bytes reach the other side after their time on a real line */
+	if(g_byteTimeUs != 0){
+
+		Host_delayUs(g_byteTimeUs * characters);
+	}
+
+	while(written < length){
+
+		result = write(g_fd, &data[written], length - written);
+
+		if(result > 0){
+
+			written += (uint16)result;
+		}
+		else if( (result < 0) && (errno == EAGAIN) ){
+
+			/* Line is full (Non blocking fd), wait till the other side reads */
+			poll(&line, 1, -1);
+		}
+		else if( (result < 0) && (errno != EINTR) ){
+
+			perror("UART host write");
+			exit(1);
+		}
+	}
+
+	g_statistics.BytesSent += characters;
+}
+
+
+/* Write characters to the line with the given 9th bit if MPCM is used */
+static void UART_hostWrite(const uint8 *data, uint8 length, uint8 ninthBit){
+
+	/* Characters as (9th bit, data) pairs */
+	uint8 line[2U * 255U];
+
+	/* Iteration variable */
+	uint8 i;
+
+	if(g_mpcmMode == MPCM_DISABLE){
+
+		UART_hostWriteLine(data, length, length);
+		return;
+	}
+
+	for(i = 0; i < length; i++){
+
+		line[2U * i]		= ninthBit;
+		line[(2U * i) + 1U]	= data[i];
+	}
+
+	UART_hostWriteLine(line, 2U * length, length);
+}
+
+
+/* Save one received byte in the Rx block */
+static void UART_rxBlockStep(uint8 data){
+
+	/* Pointer to the block callback to call it after the block is released */
+	void (*callBack)(void);
+
+	g_rxBlockPtr[g_rxBlockIndex] = data;
+	g_rxBlockIndex++;
+
+	if(g_rxBlockIndex == g_rxBlockLength){
+
+		callBack		= g_callBackPtrUartRxBlock;
+		g_rxBlockPtr	= NULL_PTR;
+
+		if(callBack != NULL_PTR){
+
+			(*callBack)();
+		}
+	}
+}
+
+
+/* Save one received data character in the Rx block or the Rx ring buffer */
+static void UART_hostReceive(uint8 data){
+
+	if(g_rxBlockPtr != NULL_PTR){
+
+		UART_rxBlockStep(data);
+	}
+	else if( (uint8)(g_rxHead - g_rxTail) < UART_RX_BUFFER_SIZE ){
+
+		g_rxBuffer[g_rxHead & UART_RX_BUFFER_MASK] = data;
+		g_rxHead++;
+
+		if( (uint8)(g_rxHead - g_rxTail) > g_statistics.MaxRxOccupancy ){
+
+			g_statistics.MaxRxOccupancy = (uint8)(g_rxHead - g_rxTail);
+		}
+	}
+	else{
+
+		g_statistics.DroppedBytes++;
+	}
+}
+
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+/* Emulated Rx ISR, runs on SIGIO and moves all waiting bytes from the line */
+static void Host_usartRxcIsr(void){
+
+	/* Bytes read from the line */
+	uint8 data[UART_RX_BUFFER_SIZE];
+
+	/* Number of read bytes */
+	ssize_t length;
+
+	/* Iteration variable */
+	ssize_t i;
+
+	/* 9th bit of the current character */
+	uint8 ninthBit;
+
+	while( (length = read(g_fd, data, sizeof(data))) > 0 ){
+
+		for(i = 0; i < length; i++){
+
+			if(g_mpcmMode == MPCM_DISABLE){
+
+				g_statistics.BytesReceived++;
+				UART_hostReceive(data[i]);
+				continue;
+			}
+
+			/* First byte of a character is its 9th bit */
+			if(g_rxNinthBit == UART_HOST_NO_NINTH_BIT){
+
+				g_rxNinthBit = data[i];
+				continue;
+			}
+
+			ninthBit		= g_rxNinthBit;
+			g_rxNinthBit	= UART_HOST_NO_NINTH_BIT;
+
+			if(g_mpcmMode == MPCM_SLAVE){
+
+				/* Address frame selects or deselects this slave */
+				if(ninthBit != 0){
+
+					g_statistics.BytesReceived++;
+
+					g_mpcmSelected = ( (data[i] == g_mpcmAddress) || (data[i] == UART_MPCM_BROADCAST_ADDRESS) ) ? TRUE : FALSE;
+					continue;
+				}
+
+				/* Data frames of other slaves are filtered like the hardware does */
+				if(g_mpcmSelected == FALSE){
+
+					continue;
+				}
+			}
+
+			g_statistics.BytesReceived++;
+			UART_hostReceive(data[i]);
+		}
+
+		if(g_callBackPtrUartRx != NULL_PTR){
+
+			(*g_callBackPtrUartRx)();
+		}
+	}
+}
+
+
+/*
+ * Poll the line from the application like the RXC flag in polling mode
+ * Signal delivery to a busy looping process may wait for the next scheduler
+ * tick (Milli seconds), so the Rx ISR is called directly when nothing is waiting
+*/
+static void UART_hostPoll(void){
+
+	uint8 sreg = SREG;
+
+	/* Rx ISR must not run from SIGIO meanwhile */
+	cli();
+
+	Host_usartRxcIsr();
+
+	SREG = sreg;
+}
+
+
+/* Start counting a new timeout in milli seconds */
+static void UART_startTimeout(uint16 timeout){
+
+	uint8 sreg = SREG;
+
+	cli();
+
+	g_timeoutTicks		= ( (timeout + UART_TIMEOUT_TICK_MS - 1U) / UART_TIMEOUT_TICK_MS );
+	g_timeoutExpired	= ( (g_timeoutTicks == 0) ? TRUE : FALSE );
+
+	SREG = sreg;
+}
+
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/********************************************************************************
+ [Function Name]:	UART_init
+
+ [Description]:		Used to open the serial line of the host build
+ 	 	 	 	 	- UART_HOST_DEVICE: path of a pty/tty (Set to raw mode)
+ 	 	 	 	 	- UART_HOST_FD:		already opened descriptor (socketpair)
+ 	 	 	 	 	- UART_HOST_BAUD:	optional line speed to pace Tx bytes
+ 	 	 	 	 	Frame format of the configuration is not needed on the host
+
+ [Args]:			config_Ptr
+
+ [in]				config_Ptr: Pointer to UART Configuration Structure
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_init(const UART_ConfigType* config_Ptr)
+{
+	const char *device	= getenv("UART_HOST_DEVICE");
+	const char *fd		= getenv("UART_HOST_FD");
+	const char *baud	= getenv("UART_HOST_BAUD");
+
+	struct termios settings;
+
+	if(device != NULL){
+
+		g_fd = open(device, O_RDWR | O_NOCTTY);
+	}
+	else if(fd != NULL){
+
+		g_fd = atoi(fd);
+	}
+
+	if( (g_fd < 0) || (fcntl(g_fd, F_GETFL) < 0) ){
+
+		fprintf(stderr, "UART host: set UART_HOST_DEVICE or UART_HOST_FD\n");
+		exit(1);
+	}
+
+	/* Pty or tty should pass bytes as they are */
+	if(isatty(g_fd) && (tcgetattr(g_fd, &settings) == 0)){
+
+		cfmakeraw(&settings);
+		tcsetattr(g_fd, TCSANOW, &settings);
+	}
+
+	g_mpcmMode		= config_Ptr->MultiProcessorMode;
+	g_mpcmAddress	= config_Ptr->Address;
+	g_mpcmSelected	= ( (g_mpcmMode == MPCM_SLAVE) ? FALSE : TRUE );
+	g_rxNinthBit	= UART_HOST_NO_NINTH_BIT;
+
+	/* Start bit, 8 data bits, 9th bit in MPCM and stop bit */
+	g_byteTimeUs = ( (baud != NULL) && (atol(baud) > 0) ) ? (uint32)( ( (g_mpcmMode == MPCM_DISABLE) ? 10000000UL : 11000000UL ) / (unsigned long)atol(baud) ) : 0;
+
+	g_rxHead		= 0;
+	g_rxTail		= 0;
+	g_rxBlockPtr	= NULL_PTR;
+
+	UART_resetStatistics();
+
+	/* Received bytes raise SIGIO which is the Rx interrupt */
+	Host_setInterrupt(HOST_VECTOR_USART_RXC, Host_usartRxcIsr);
+
+	fcntl(g_fd, F_SETOWN, getpid());
+	fcntl(g_fd, F_SETFL, fcntl(g_fd, F_GETFL) | O_NONBLOCK | O_ASYNC);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_setCallBackTx
+
+ [Description]:		Function Callback called after every sent byte
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to void function
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_setCallBackTx(void (*f_ptr)(void)){
+	g_callBackPtrUartTx = f_ptr;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_setCallBackRx
+
+ [Description]:		Function Callback called from the emulated Rx ISR
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to void function
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_setCallBackRx(void (*f_ptr)(void)){
+	g_callBackPtrUartRx = f_ptr;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_setCallBackTxDrain
+
+ [Description]:		Function Callback called when all sent bytes are written
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to void function
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_setCallBackTxDrain(void (*f_ptr)(void)){
+	g_callBackPtrUartTxDrain = f_ptr;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_sendByte
+
+ [Description]:		Function used to send byte on the host serial line
+
+ [Args]:			data
+
+ [in]				data: constant unsigned char which has the byte to be sent
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_sendByte(const uint8 data)
+{
+	UART_hostWrite(&data, 1, 0);
+
+	if(g_callBackPtrUartTx != NULL_PTR){
+
+		(*g_callBackPtrUartTx)();
+	}
+
+	if(g_callBackPtrUartTxDrain != NULL_PTR){
+
+		(*g_callBackPtrUartTxDrain)();
+	}
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_sendAddress
+
+ [Description]:		Function used to send an address frame (9th bit is 1) in
+ 	 	 	 	 	MPCM_MASTER mode to select the slave of the next data bytes
+ 	 	 	 	 	- UART_MPCM_BROADCAST_ADDRESS selects all slaves
+
+ [Args]:			address
+
+ [in]				address: Address of the slave
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_sendAddress(uint8 address)
+{
+	UART_hostWrite(&address, 1, 1);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_sendBuffer
+
+ [Description]:		Function used to send number of bytes as one operation
+ 	 	 	 	 	(Written at once on the host, callback is called before return)
+
+ [Args]:			buffer, length, f_ptr
+
+ [in]				buffer: Pointer to the bytes to be sent
+ 	 	 	 	 	length: Number of bytes to be sent
+ 	 	 	 	 	f_ptr:	Pointer to void function called when the block is sent
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			UART_OK
+**********************************************************************************/
+UART_StatusType UART_sendBuffer(const uint8 *buffer, uint8 length, void (*f_ptr)(void))
+{
+	UART_hostWrite(buffer, length, 0);
+
+	if(f_ptr != NULL_PTR){
+
+		(*f_ptr)();
+	}
+
+	return UART_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_receiveBuffer
+
+ [Description]:		Function used to receive number of bytes as one operation
+ 	 	 	 	 	- Bytes already waiting in Rx ring buffer are taken first
+ 	 	 	 	 	- Rest of bytes are saved by the emulated Rx ISR
+
+ [Args]:			buffer, length, f_ptr
+
+ [in]				length: Number of bytes to be received
+ 	 	 	 	 	f_ptr:	Pointer to void function called when the last byte
+ 	 	 	 	 	 	 	is received (NULL_PTR if not needed)
+
+ [out]				buffer: Pointer to an array to save the received bytes on it
+
+ [in/out]			None
+
+ [Returns]:			UART_OK if the transfer started, UART_BUSY if a previous
+ 	 	 	 	 	block is still being received
+**********************************************************************************/
+UART_StatusType UART_receiveBuffer(uint8 *buffer, uint8 length, void (*f_ptr)(void))
+{
+	uint8 sreg;
+	uint8 data;
+
+	if(g_rxBlockPtr != NULL_PTR){
+
+		return UART_BUSY;
+	}
+
+	if(length == 0){
+
+		if(f_ptr != NULL_PTR){
+
+			(*f_ptr)();
+		}
+
+		return UART_OK;
+	}
+
+	sreg = SREG;
+
+	cli();
+
+	g_callBackPtrUartRxBlock	= f_ptr;
+	g_rxBlockLength				= length;
+	g_rxBlockIndex				= 0;
+	g_rxBlockPtr				= buffer;
+
+	while( (g_rxBlockPtr != NULL_PTR) && (g_rxHead != g_rxTail) ){
+
+		data = g_rxBuffer[g_rxTail & UART_RX_BUFFER_MASK];
+		g_rxTail++;
+
+		UART_rxBlockStep(data);
+	}
+
+	SREG = sreg;
+
+	return UART_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_flush
+
+ [Description]:		Function used to wait until the sent bytes leave the line
+ 	 	 	 	 	(Only needed for a tty, socket writes are done already)
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_flush(void)
+{
+	if(isatty(g_fd)){
+
+		tcdrain(g_fd);
+	}
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_recieveByte
+
+ [Description]:		Function used to receive a byte from the host serial line
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Byte recived by UART
+**********************************************************************************/
+uint8 UART_recieveByte(void)
+{
+	uint8 data;
+
+	while(UART_read(&data) == FALSE){}
+
+	return data;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_recieveByteTimeout
+
+ [Description]:		Function used to receive a byte within a bounded time
+
+ [Args]:			data, timeout
+
+ [in]				timeout: Maximum time to wait in milli seconds
+
+ [out]				data: Pointer to unsigned char to save the received byte on it
+
+ [in/out]			None
+
+ [Returns]:			UART_OK if a byte is received, UART_TIMEOUT otherwise
+**********************************************************************************/
+UART_StatusType UART_recieveByteTimeout(uint8 *data, uint16 timeout)
+{
+	if(UART_read(data) == TRUE){
+
+		return UART_OK;
+	}
+
+	UART_startTimeout(timeout);
+
+	while(UART_read(data) == FALSE){
+
+		if(g_timeoutExpired == TRUE){
+
+			return UART_TIMEOUT;
+		}
+	}
+
+	return UART_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_receiveBufferTimeout
+
+ [Description]:		Function used to receive number of bytes within a bounded
+ 	 	 	 	 	time for the whole buffer
+
+ [Args]:			buffer, length, timeout
+
+ [in]				length:	 Number of bytes to be received
+ 	 	 	 	 	timeout: Maximum time to wait for all bytes in milli seconds
+
+ [out]				buffer: Pointer to an array to save the received bytes on it
+
+ [in/out]			None
+
+ [Returns]:			UART_OK if all bytes are received, UART_TIMEOUT otherwise
+**********************************************************************************/
+UART_StatusType UART_receiveBufferTimeout(uint8 *buffer, uint8 length, uint16 timeout)
+{
+	uint8 i = 0;
+
+	UART_startTimeout(timeout);
+
+	while(i < length){
+
+		if(UART_read(&buffer[i]) == TRUE){
+
+			i++;
+		}
+		else if(g_timeoutExpired == TRUE){
+
+			return UART_TIMEOUT;
+		}
+	}
+
+	return UART_OK;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_timeoutTick
+
+ [Description]:		Time base of UART timeouts, it should be given as a callback
+ 	 	 	 	 	to a timer which interrupts every UART_TIMEOUT_TICK_MS
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_timeoutTick(void)
+{
+	if(g_timeoutTicks > 0){
+
+		g_timeoutTicks--;
+
+		if(g_timeoutTicks == 0){
+
+			g_timeoutExpired = TRUE;
+		}
+	}
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_available
+
+ [Description]:		Function used to know how many bytes are waiting in the
+ 	 	 	 	 	Rx ring buffer
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			Number of received bytes ready to be read
+**********************************************************************************/
+uint8 UART_available(void)
+{
+	if(g_rxHead == g_rxTail){
+
+		UART_hostPoll();
+
+		/* Firmware waits in busy loops, give the CPU to the other ECU process meanwhile */
+		if(g_rxHead == g_rxTail){
+
+			sched_yield();
+		}
+	}
+
+	return (uint8)(g_rxHead - g_rxTail);
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_peek
+
+ [Description]:		Function used to get the oldest received byte without
+ 	 	 	 	 	removing it from the Rx ring buffer (Non blocking)
+
+ [Args]:			data
+
+ [in]				None
+
+ [out]				data: Pointer to unsigned char to save the byte on it
+
+ [in/out]			None
+
+ [Returns]:			TRUE if a byte is available, FALSE if buffer is empty
+**********************************************************************************/
+uint8 UART_peek(uint8 *data)
+{
+	if(UART_available() == 0){
+
+		return FALSE;
+	}
+
+	*data = g_rxBuffer[g_rxTail & UART_RX_BUFFER_MASK];
+
+	return TRUE;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_read
+
+ [Description]:		Function used to get the oldest received byte and remove it
+ 	 	 	 	 	from the Rx ring buffer (Non blocking)
+
+ [Args]:			data
+
+ [in]				None
+
+ [out]				data: Pointer to unsigned char to save the byte on it
+
+ [in/out]			None
+
+ [Returns]:			TRUE if a byte is read, FALSE if buffer is empty
+**********************************************************************************/
+uint8 UART_read(uint8 *data)
+{
+	if(UART_available() == 0){
+
+		return FALSE;
+	}
+
+	*data = g_rxBuffer[g_rxTail & UART_RX_BUFFER_MASK];
+	g_rxTail++;
+
+	return TRUE;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_sendString
+
+ [Description]:		Function used to send a string till before Null terminator
+
+ [Args]:			Str
+
+ [in]				Str: Constant pointer to the string to be sent
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_sendString(const uint8 *Str)
+{
+	uint8 i = 0;
+	while(Str[i] != '\0')
+	{
+		UART_sendByte(Str[i]);
+		i++;
+	}
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_receiveString
+
+ [Description]:		Function used to receive a string till '#' sign
+
+ [Args]:			Str
+
+ [in]				Str: Pointer to an empty string filled by this function
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_receiveString(uint8 *Str)
+{
+	uint8 i = 0;
+	Str[i] = UART_recieveByte();
+	while(Str[i] != '#')
+	{
+		i++;
+		Str[i] = UART_recieveByte();
+	}
+	Str[i] = '\0';
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_getStatistics
+
+ [Description]:		Function used to take a copy of the link statistics
+ 	 	 	 	 	(Line errors never happen on the host so they stay zero)
+
+ [Args]:			statistics_Ptr
+
+ [in]				None
+
+ [out]				statistics_Ptr: Pointer to structure to save the statistics on it
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_getStatistics(UART_StatisticsType *statistics_Ptr)
+{
+	uint8 sreg = SREG;
+
+	cli();
+
+	*statistics_Ptr = *(const UART_StatisticsType*)&g_statistics;
+
+	SREG = sreg;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_resetStatistics
+
+ [Description]:		Function used to clear all the link statistics counters
+
+ [Args]:			None
+
+ [in]				None
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_resetStatistics(void)
+{
+	uint8 sreg = SREG;
+
+	cli();
+
+	g_statistics.BytesSent		= 0;
+	g_statistics.BytesReceived	= 0;
+	g_statistics.OverrunErrors	= 0;
+	g_statistics.FramingErrors	= 0;
+	g_statistics.ParityErrors	= 0;
+	g_statistics.DroppedBytes	= 0;
+	g_statistics.MaxRxOccupancy	= 0;
+
+	SREG = sreg;
+}
+
+
+
+/********************************************************************************
+ [Function Name]:	UART_dumpStatistics
+
+ [Description]:		Function used to give every statistics counter with its name
+ 	 	 	 	 	to a print function
+
+ [Args]:			f_ptr
+
+ [in]				f_ptr: Pointer to function which prints one counter
+
+ [out]				None
+
+ [in/out]			None
+
+ [Returns]:			None
+**********************************************************************************/
+void UART_dumpStatistics(void (*f_ptr)(const uint8 *name, uint32 value))
+{
+	UART_StatisticsType statistics;
+
+	UART_getStatistics(&statistics);
+
+	(*f_ptr)((const uint8*)"TX", statistics.BytesSent);
+	(*f_ptr)((const uint8*)"RX", statistics.BytesReceived);
+	(*f_ptr)((const uint8*)"DOR", statistics.OverrunErrors);
+	(*f_ptr)((const uint8*)"FE", statistics.FramingErrors);
+	(*f_ptr)((const uint8*)"PE", statistics.ParityErrors);
+	(*f_ptr)((const uint8*)"DROP", statistics.DroppedBytes);
+	(*f_ptr)((const uint8*)"RXMAX", statistics.MaxRxOccupancy);
+}